@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CRobes/Constants.hpp"
+#include "CRobes/Space.hpp"
+#include "CRobes/Batch.hpp"
+
+// Benchmark Settings
+constexpr unsigned int MATRIX_COUNT {4096u};
+constexpr unsigned int ITERATIONS   {256u};
+constexpr unsigned int POINT_COUNT  {1u << 20};
+constexpr unsigned int BATCH_PASSES {16u};
+
+// Prevents the optimizer from discarding benchmark results
+volatile float sink {0.f};
+
+// Random Matrices
+std::vector<crb::Space::Mat4> createMatrices(const bool affine)
+{
+  std::mt19937 generator {1337u};
+  std::uniform_real_distribution<float> distribution {-4.f, 4.f};
+
+  std::vector<crb::Space::Mat4> matrices(MATRIX_COUNT);
+  for (crb::Space::Mat4& mat : matrices)
+  {
+    for (int y = 0; y < 4; y++)
+    {
+      for (int x = 0; x < 4; x++)
+      {
+        mat[y][x] = distribution(generator);
+      }
+    }
+    // Keeping the matrices well conditioned
+    for (int i = 0; i < 4; i++)
+    {
+      mat[i][i] += 10.f;
+    }
+    if (affine)
+    {
+      mat[0][3] = 0.f;
+      mat[1][3] = 0.f;
+      mat[2][3] = 0.f;
+      mat[3][3] = 1.f;
+    }
+  }
+  return matrices;
+}
+
+// Largest element-wise difference between two matrices
+float maxError(const crb::Space::Mat4& matOne, const crb::Space::Mat4& matTwo)
+{
+  float error {0.f};
+  for (int y = 0; y < 4; y++)
+  {
+    for (int x = 0; x < 4; x++)
+    {
+      error = std::max(error, std::fabs(matOne[y][x] - matTwo[y][x]));
+    }
+  }
+  return error;
+}
+
+// Runs a kernel over all matrices and returns the average time per call in nanoseconds
+template <typename Kernel>
+double measure(const Kernel& kernel)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned int iteration = 0; iteration < ITERATIONS; iteration++)
+  {
+    for (unsigned int i = 0; i < MATRIX_COUNT; i++)
+    {
+      sink = sink + kernel(i);
+    }
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / (ITERATIONS * MATRIX_COUNT);
+}
+
+// Runs a batch kernel several times and returns the throughput in millions of points per second
+template <typename Kernel>
+double measureBatch(const Kernel& kernel)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned int pass = 0; pass < BATCH_PASSES; pass++)
+  {
+    kernel();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return (double)POINT_COUNT * BATCH_PASSES / std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+void reportBatch(const std::string& name, const double perPoint, const double batch)
+{
+  std::cout << std::left << std::setw(16) << name
+            << std::right << std::fixed << std::setprecision(1)
+            << std::setw(10) << perPoint << " Mp/s"
+            << std::setw(10) << batch << " Mp/s"
+            << std::setw(9) << std::setprecision(2) << batch / perPoint << "x\n";
+}
+
+void report(const std::string& name, const double scalarTime, const double simdTime, const float error)
+{
+  std::cout << std::left << std::setw(16) << name
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(10) << scalarTime << " ns"
+            << std::setw(10) << simdTime << " ns"
+            << std::setw(9) << scalarTime / simdTime << "x"
+            << std::scientific << std::setprecision(1)
+            << std::setw(12) << error << '\n';
+}
+
+int main()
+{
+  const std::vector<crb::Space::Mat4> matrices = createMatrices(false);
+  const std::vector<crb::Space::Mat4> affineMatrices = createMatrices(true);
+
+  std::cout << crb::ENGINE_NAME << " " << crb::ENGINE_VERSION << " - Math Benchmark\n";
+  std::cout << "Kernels: " << crb::Space::SIMD_BACKEND << "; " << MATRIX_COUNT << " matrices x " << ITERATIONS << " iterations\n\n";
+  std::cout << std::left << std::setw(16) << "Kernel"
+            << std::right << std::setw(13) << "Scalar"
+            << std::setw(13) << "SIMD"
+            << std::setw(10) << "Speedup"
+            << std::setw(12) << "Max Error" << '\n';
+
+  // Mat4 x Mat4
+  {
+    float error {0.f};
+    for (unsigned int i = 0; i < MATRIX_COUNT; i++)
+    {
+      const crb::Space::Mat4& next = matrices[(i + 1) % MATRIX_COUNT];
+      error = std::max(error, maxError(crb::Space::Scalar::multiply(matrices[i], next), crb::Space::multiply(matrices[i], next)));
+    }
+    const double scalarTime = measure([&](const unsigned int i)
+    { return crb::Space::Scalar::multiply(matrices[i], matrices[(i + 1) % MATRIX_COUNT])[1][2]; });
+    const double simdTime = measure([&](const unsigned int i)
+    { return crb::Space::multiply(matrices[i], matrices[(i + 1) % MATRIX_COUNT])[1][2]; });
+    report("Mat4 x Mat4", scalarTime, simdTime, error);
+  }
+
+  // Mat4 x Vec4
+  {
+    const crb::Space::Vec4 vec {1.f, 2.f, 3.f, 1.f};
+    float error {0.f};
+    for (unsigned int i = 0; i < MATRIX_COUNT; i++)
+    {
+      const crb::Space::Vec4 scalar = crb::Space::Scalar::transform(matrices[i], vec);
+      const crb::Space::Vec4 simd = crb::Space::transform(matrices[i], vec);
+      error = std::max({error, std::fabs(scalar.x - simd.x), std::fabs(scalar.y - simd.y), std::fabs(scalar.z - simd.z), std::fabs(scalar.w - simd.w)});
+    }
+    const double scalarTime = measure([&](const unsigned int i)
+    { return crb::Space::Scalar::transform(matrices[i], vec).y; });
+    const double simdTime = measure([&](const unsigned int i)
+    { return crb::Space::transform(matrices[i], vec).y; });
+    report("Mat4 x Vec4", scalarTime, simdTime, error);
+  }
+
+  // Affine Inverse
+  {
+    float error {0.f};
+    for (unsigned int i = 0; i < MATRIX_COUNT; i++)
+    {
+      error = std::max(error, maxError(crb::Space::Scalar::affineInverse(affineMatrices[i]), crb::Space::affineInverse(affineMatrices[i])));
+      error = std::max(error, maxError(crb::Space::multiply(affineMatrices[i], crb::Space::affineInverse(affineMatrices[i])), crb::Space::Mat4(1.f)));
+    }
+    const double scalarTime = measure([&](const unsigned int i)
+    { return crb::Space::Scalar::affineInverse(affineMatrices[i])[3][0]; });
+    const double simdTime = measure([&](const unsigned int i)
+    { return crb::Space::affineInverse(affineMatrices[i])[3][0]; });
+    report("Affine Inverse", scalarTime, simdTime, error);
+  }
+
+  // General Inverse
+  {
+    float error {0.f};
+    for (unsigned int i = 0; i < MATRIX_COUNT; i++)
+    {
+      error = std::max(error, maxError(crb::Space::Scalar::inverse(matrices[i]), crb::Space::inverse(matrices[i])));
+      error = std::max(error, maxError(crb::Space::multiply(matrices[i], crb::Space::inverse(matrices[i])), crb::Space::Mat4(1.f)));
+    }
+    const double scalarTime = measure([&](const unsigned int i)
+    { return crb::Space::Scalar::inverse(matrices[i])[2][1]; });
+    const double simdTime = measure([&](const unsigned int i)
+    { return crb::Space::inverse(matrices[i])[2][1]; });
+    report("Inverse", scalarTime, simdTime, error);
+  }
+
+  // Batch Kernels
+  std::mt19937 generator {42u};
+  std::uniform_real_distribution<float> distribution {-100.f, 100.f};
+
+  std::vector<crb::Space::Vec3> points(POINT_COUNT);
+  crb::Batch::Vec3Array pointArray;
+  pointArray.reserve(POINT_COUNT);
+  for (crb::Space::Vec3& point : points)
+  {
+    point = {distribution(generator), distribution(generator), distribution(generator)};
+    pointArray.push(point);
+  }
+
+  std::vector<crb::Space::Vec3> results(POINT_COUNT);
+  std::vector<float> scalars(POINT_COUNT);
+  crb::Batch::Vec3Array resultArray {POINT_COUNT};
+  crb::Space::Mat4 mat = matrices[0];
+
+  std::cout << '\n' << std::left << std::setw(16) << "Batch Kernel"
+            << std::right << std::setw(15) << "Per Point"
+            << std::setw(15) << "Batch"
+            << std::setw(10) << "Speedup" << '\n';
+
+  reportBatch("Transform", measureBatch([&]()
+  {
+    for (unsigned int i = 0; i < POINT_COUNT; i++)
+    {
+      const crb::Space::Vec4 result = mat * crb::Space::Vec4(points[i], 1.f);
+      results[i] = {result.x, result.y, result.z};
+    }
+  }), measureBatch([&]()
+  { crb::Batch::transform(mat, pointArray, resultArray); }));
+
+  reportBatch("Dot", measureBatch([&]()
+  {
+    for (unsigned int i = 0; i < POINT_COUNT; i++)
+    {
+      scalars[i] = crb::Space::dot(points[i], results[i]);
+    }
+  }), measureBatch([&]()
+  { crb::Batch::dot(pointArray, resultArray, scalars.data()); }));
+
+  reportBatch("Cross", measureBatch([&]()
+  {
+    for (unsigned int i = 0; i < POINT_COUNT; i++)
+    {
+      results[i] = crb::Space::cross(points[i], results[i]);
+    }
+  }), measureBatch([&]()
+  { crb::Batch::cross(pointArray, pointArray, resultArray); }));
+
+  reportBatch("Length", measureBatch([&]()
+  {
+    for (unsigned int i = 0; i < POINT_COUNT; i++)
+    {
+      scalars[i] = crb::Space::lengthOf(points[i]);
+    }
+  }), measureBatch([&]()
+  { crb::Batch::lengthOf(pointArray, scalars.data()); }));
+
+  reportBatch("Normalize", measureBatch([&]()
+  {
+    for (unsigned int i = 0; i < POINT_COUNT; i++)
+    {
+      results[i] = crb::Space::normalize(points[i]);
+    }
+  }), measureBatch([&]()
+  { crb::Batch::normalize(pointArray, resultArray); }));
+
+  crb::Space::Vec3 minimum;
+  crb::Space::Vec3 maximum;
+  reportBatch("Bounds", measureBatch([&]()
+  {
+    minimum = points[0];
+    maximum = points[0];
+    for (const crb::Space::Vec3& point : points)
+    {
+      minimum = {std::min(minimum.x, point.x), std::min(minimum.y, point.y), std::min(minimum.z, point.z)};
+      maximum = {std::max(maximum.x, point.x), std::max(maximum.y, point.y), std::max(maximum.z, point.z)};
+    }
+  }), measureBatch([&]()
+  { crb::Batch::bounds(pointArray, minimum, maximum); }));
+  sink = sink + minimum.x + maximum.x + scalars[0] + resultArray.getX()[0] + results[0].x;
+
+  return EXIT_SUCCESS;
+}
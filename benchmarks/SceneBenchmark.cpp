@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "CRobes/CameraPath.hpp"
+#include "CRobes/Constants.hpp"
+#include "CRobes/Core.hpp"
+#include "CRobes/Space.hpp"
+
+#include "Scene.hpp"
+
+// Benchmark Settings
+constexpr unsigned int FRAME_COUNT  {1000u};
+constexpr unsigned int FRAME_WIDTH  {1280u};
+constexpr unsigned int FRAME_HEIGHT {720u};
+const     std::string  STATS_PATH   {"bench_frame_stats.json"};
+const     std::string  CAPTURE_PATH {"captures/frame_"};
+
+// Camera Path
+constexpr float PATH_RADIUS {96.f};
+constexpr float PATH_HEIGHT {12.f};
+constexpr float PATH_PITCH  {-15.f};
+
+// Renders the example scene offscreen while flying the camera around a circle, or along a recorded path
+class BenchmarkWindow : public SceneWindow
+{
+  public:
+    BenchmarkWindow(const unsigned int width, const unsigned int height, const unsigned int frameCount, const crb::ChunkManager::Storage chunkStorage)
+    : SceneWindow(width, height, WINDOW_TITLE, crb::Window::Headless, chunkStorage), frameCount(frameCount)
+    {}
+
+    const crb::ChunkManager& getChunkManager() const
+    { return this->chunkManager; }
+
+    // Replaces the circle with a path recorded by the example
+    void play(const crb::CameraPath& path)
+    {
+      this->path = &path;
+      this->startPlayback(path);
+    }
+
+    // Waits for the chunks around the start of the path, so loading is not measured
+    void warmUp()
+    {
+      if (this->path != NULL && this->path->getFrameCount() > 0)
+      {
+        this->path->apply(0, this->camera);
+      }
+      else
+      {
+        this->_placeCamera();
+      }
+      this->chunkManager.update(this->camera.getPosition());
+      while (this->chunkManager.getPendingCount() > 0)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        this->chunkManager.update(this->camera.getPosition());
+      }
+    }
+
+  protected:
+    void update()
+    {
+      this->frame++;
+      if (this->path == NULL)
+      {
+        this->_placeCamera();
+      }
+      SceneWindow::update();
+      if (this->path != NULL ? !this->isPlayingBack() : this->frame >= this->frameCount)
+      {
+        this->close();
+      }
+    }
+
+  private:
+    // The path advances by frame rather than by time, so every run renders the same frames
+    void _placeCamera()
+    {
+      const float angle = 360.f * this->frame / this->frameCount;
+      const float radians = crb::Space::radians(angle);
+      this->camera.setPosition({PATH_RADIUS * cosf(radians), PATH_HEIGHT, PATH_RADIUS * sinf(radians)});
+      this->camera.setRotation(angle + 90.f, PATH_PITCH);
+    }
+
+    const crb::CameraPath* path {NULL};
+
+    unsigned int frameCount {FRAME_COUNT};
+    unsigned int frame      {0u};
+};
+
+// Usage: crobes-bench-scene [frames] [width] [height] [camera path, or - for the circle] [capture interval] [chunk storage]
+int main(int argc, char* argv[])
+{
+  unsigned int frameCount = argc > 1 ? std::max(std::atoi(argv[1]), 1) : FRAME_COUNT;
+  const unsigned int width = argc > 2 ? std::max(std::atoi(argv[2]), 1) : FRAME_WIDTH;
+  const unsigned int height = argc > 3 ? std::max(std::atoi(argv[3]), 1) : FRAME_HEIGHT;
+  const unsigned int captureInterval = argc > 5 ? std::max(std::atoi(argv[5]), 0) : 0u;
+
+  crb::ChunkManager::Storage chunkStorage {DEFAULT_CHUNK_STORAGE};
+  if (argc > 6 && !parseChunkStorage(argv[6], chunkStorage))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // A recorded path sets the number of frames
+  crb::CameraPath cameraPath;
+  if (argc > 4 && std::string(argv[4]) != "-")
+  {
+    if (!cameraPath.load(argv[4]) || cameraPath.getFrameCount() == 0)
+    {
+      return EXIT_FAILURE;
+    }
+    frameCount = (unsigned int)cameraPath.getFrameCount();
+  }
+
+  // No display server is needed
+  crb::Core::initializeGlfw(true);
+
+  double seconds {0.0};
+  {
+    BenchmarkWindow window {width, height, frameCount, chunkStorage};
+    window.initialize();
+    if (cameraPath.getFrameCount() > 0)
+    {
+      window.play(cameraPath);
+    }
+    window.setClearColor({220, 220, 220, 1.f});
+    window.getFrameCapture().setInterval(captureInterval, CAPTURE_PATH);
+    window.warmUp();
+
+    std::cout << crb::ENGINE_NAME << " " << crb::ENGINE_VERSION << " - Scene Benchmark\n";
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << '\n';
+    std::cout << frameCount << " frames at " << width << "x" << height << "\n\n";
+
+    const auto start = std::chrono::steady_clock::now();
+    window.loop();
+    glFinish();
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const crb::FrameStats::Summary summary = window.getFrameStats().getSummary();
+    const crb::Graphics::GpuTimer& gpuTimer = window.getGpuTimer();
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Throughput:  " << frameCount / seconds << " frames/s (" << seconds << " s)\n";
+    std::cout << "Frame time:  mean " << summary.mean << " ms, p50 " << summary.p50 << " ms, p95 " << summary.p95
+              << " ms, p99 " << summary.p99 << " ms, max " << summary.max << " ms\n";
+    std::cout << "Missed:      " << summary.missed << " frames over " << window.getFrameStats().getTargetMilliseconds() << " ms\n";
+    std::cout << "GPU passes:  opaque " << gpuTimer.getMilliseconds("Opaque") << " ms, overlay " << gpuTimer.getMilliseconds("Overlay") << " ms\n";
+    if (chunkStorage == crb::ChunkManager::Solids)
+    {
+      const crb::ChunkManager& chunkManager = window.getChunkManager();
+      std::cout << "Mesh cache:  " << chunkManager.getMeshCache().getHitCount() << " hits, " << chunkManager.getMeshCache().getMissCount() << " misses, "
+                << crb::Graphics::getMeshCount() << " live meshes\n";
+    }
+    if (captureInterval > 0)
+    {
+      window.getFrameCapture().finish();
+      std::cout << "Captures:    " << window.getFrameCapture().getWrittenCount() << " written, " << window.getFrameCapture().getDroppedCount() << " dropped\n";
+    }
+    window.getFrameStats().writeJSON(STATS_PATH);
+  }
+
+  glfwTerminate();
+  return EXIT_SUCCESS;
+}
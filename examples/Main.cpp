@@ -6,143 +6,27 @@
 #include <iostream>
 #include <string>
 
-#include "CRobes/Constants.hpp"
-#include "CRobes/Core.hpp"
-#include "CRobes/Color.hpp"
-#include "CRobes/Graphics.hpp"
-#include "CRobes/Window.hpp"
-#include "CRobes/Space.hpp"
-#include "CRobes/Camera.hpp"
-#include "CRobes/Solids.hpp"
-#include "CRobes/GUI.hpp"
 #include "CRobes/Debug.hpp"
+#include "CRobes/Profiler.hpp"
 
-// Window Settings
-constexpr unsigned int WINDOW_WIDTH  {800u};
-constexpr unsigned int WINDOW_HEIGHT {600u};
-const     std::string  WINDOW_TITLE  {crb::ENGINE_NAME + " " + crb::ENGINE_VERSION};
-
-// Camera Settings
-constexpr float CAMERA_FOV         {60.f};
-constexpr float CAMERA_NEAR        {0.1f};
-constexpr float CAMERA_FAR         {512.f};
-constexpr float CAMERA_SPEED       {5.f};
-constexpr float CAMERA_SENSITIVITY {0.1};
+#include "Scene.hpp"
 
 // Settings
-constexpr unsigned int RENDER_DISTANCE {8};
-
-// Camera Position
-const crb::Space::Vec3 defaultCameraPosition {8.f, 1.8f, 8.f};
-
-// Solid Factory
-crb::Solids::SolidFactory solidFactory;
+const     std::string SHADER_CACHE_DIRECTORY {"cache/shaders"};
+const     std::string PROFILER_TRACE_PATH    {"trace.json"};
+const     std::string FRAME_STATS_PATH       {"frame_stats"};
+const     std::string CAMERA_PATH_PATH       {"camera_path.bin"};
 
 // Window Class
-class MainWindow : public crb::Window
+class MainWindow : public SceneWindow
 {
   public:
-    using crb::Window::Window;
-
-    ~MainWindow()
-    {
-      this->defaultShader.Delete();
-    }
-
-    void initialize()
-    {
-      this->bindCamera(this->camera);
-      this->camera.setPosition(defaultCameraPosition);
-      this->chunks.reserve(pow(RENDER_DISTANCE * 2 - 1, 2));
-
-      for (int z = 0; z < 3; z++)
-      {
-        for (int x = 0; x < 3; x++)
-        {
-          this->chunks.emplace_back(solidFactory.createPlane(
-            {(x - 1) * crb::CHUNK_SIZE, 0.f, (z - 1) * crb::CHUNK_SIZE},
-            crb::CHUNK_SIZE,
-            crb::CHUNK_SIZE,
-            crb::CHUNK_SEGMENTS
-          ));
-        }
-      }
-    }
+    using SceneWindow::SceneWindow;
 
   protected:
-    std::vector<std::pair<int, int>> calculateRequiredChunks()
-    {
-      std::vector<std::pair<int, int>> chunks;
-
-      int cameraChunkX = crb::Space::getChunkX(this->camera.getPosition());
-      int cameraChunkZ = crb::Space::getChunkZ(this->camera.getPosition());
-
-      for (int z = 0; z < RENDER_DISTANCE * 2 - 1; z++)
-      {
-        for (int x = 0; x < RENDER_DISTANCE * 2 - 1; x++)
-        {
-          chunks.push_back(std::pair(
-            x - RENDER_DISTANCE + cameraChunkX + 1,
-            z - RENDER_DISTANCE + cameraChunkZ + 1
-          ));
-        }
-      }
-
-      return chunks;
-    }
-
-    void updateChunks()
-    {
-      std::vector<std::pair<int, int>> requiredChunks = this->calculateRequiredChunks();
-
-      this->chunks.erase(std::remove_if(
-        this->chunks.begin(),
-        this->chunks.end(),
-        [&](const crb::Solids::Solid& chunk)
-        {
-          for (const auto& chunkPosition : requiredChunks)
-          {
-            if (
-              crb::Space::getChunkX(chunk.getPosition().x) == chunkPosition.first &&
-              crb::Space::getChunkZ(chunk.getPosition().z) == chunkPosition.second
-            ) return false;
-          }
-          return true;
-        }
-      ), this->chunks.end());
-
-      for (const auto& chunkPosition : requiredChunks)
-      {
-        bool chunkFound {false};
-        for (const auto& chunk : this->chunks)
-        {
-          if (
-            crb::Space::getChunkX(chunk.getPosition().x) == chunkPosition.first &&
-            crb::Space::getChunkZ(chunk.getPosition().z) == chunkPosition.second
-          ) chunkFound = true;
-        }
-        if (!chunkFound)
-        {
-          this->chunks.emplace_back(solidFactory.createPlane(
-            {chunkPosition.first * crb::CHUNK_SIZE, 0.f, chunkPosition.second * crb::CHUNK_SIZE},
-            crb::CHUNK_SIZE,
-            crb::CHUNK_SIZE,
-            crb::CHUNK_SEGMENTS
-          ));
-        }
-      }
-    }
-
     void update()
     {
-      this->updateChunks();
-
-      const unsigned int bufferWidth = this->getWidth();
-      const unsigned int bufferHeight = this->getHeight();
-      this->crosshair.setPosition({
-        (float)bufferWidth / 2.f - 8.f,
-        (float)bufferHeight / 2.f - 8.f
-      });
+      SceneWindow::update();
 
       if (this->isKeyPressed(crb::Key::E))
       { this->setMouseLocked(true); }
@@ -215,75 +99,32 @@ class MainWindow : public crb::Window
       });
     }
 
-    void render()
-    {
-      this->bindShader(this->defaultShader);
-      this->camera.use3D();
-      this->camera.applyMatrix(this->defaultShader);
-      soilTexture.Bind();
-      soilTexture.ApplyUnit(this->defaultShader, 0);
-      for (const crb::Solids::Solid& chunk : this->chunks)
-      {
-        chunk.render(this->defaultShader, GL_TRIANGLE_STRIP);
-      }
-      this->bindShader(this->guiShader);
-      this->camera.use2D();
-      this->camera.applyMatrix(this->guiShader);
-      crosshairTexture.Bind();
-      crosshairTexture.ApplyUnit(this->guiShader, 0);
-      this->crosshair.render(this->guiShader);
-      this->bindShader(this->defaultShader);
-    }
-
   private:
-    crb::Graphics::Shader defaultShader
-    {
-      "resources/Shaders/default.vert",
-      "resources/Shaders/default.frag"
-    };
-    crb::Graphics::Shader guiShader
-    {
-      "resources/Shaders/gui.vert",
-      "resources/Shaders/gui.frag"
-    };
-    crb::Graphics::Texture soilTexture
-    {
-      "resources/Textures/soil.png",
-      GL_TEXTURE_2D
-    };
-    crb::Graphics::Texture crosshairTexture
-    {
-      "resources/Textures/crosshair.png",
-      GL_TEXTURE_2D
-    };
-    crb::Camera camera
-    {
-      CAMERA_FOV,
-      WINDOW_WIDTH,
-      WINDOW_HEIGHT,
-      CAMERA_NEAR,
-      CAMERA_FAR,
-      CAMERA_SPEED,
-      CAMERA_SENSITIVITY
-    };
-    crb::GUI::Element crosshair {
-      {0.f, 0.f}, 0.f, 0.f, 16.f, 16.f
-    };
-    std::vector<crb::Solids::Solid> chunks;
-
     bool canFullscreen {true};
 };
 
-int main()
+// Usage: crobes-example [chunk storage: solids, instances or arena]
+int main(int argc, char* argv[])
 {
+  crb::ChunkManager::Storage chunkStorage {DEFAULT_CHUNK_STORAGE};
+  if (argc > 1 && !parseChunkStorage(argv[1], chunkStorage))
+  {
+    return EXIT_FAILURE;
+  }
+
   crb::Core::initializeGlfw();
 
+  // Compiled shader programs are reused across launches
+  crb::Graphics::Shader::setBinaryCacheDirectory(SHADER_CACHE_DIRECTORY);
+
   // Window
   MainWindow window
   {
     WINDOW_WIDTH,
     WINDOW_HEIGHT,
-    WINDOW_TITLE
+    WINDOW_TITLE,
+    crb::Window::Windowed,
+    chunkStorage
   };
   window.initialize();
   window.setClearColor({220, 220, 220, 1.f});
@@ -297,8 +138,21 @@ int main()
   crb::Graphics::useLineMode();
   crb::Graphics::setPointSize(5.f);
 
-  // Main Loop
+  // Main Loop, recorded for crobes-bench-scene
+  crb::CameraPath cameraPath;
+  window.startRecording(cameraPath);
   window.loop();
+  window.stopRecording();
+  cameraPath.save(CAMERA_PATH_PATH);
+
+  // Frame time summary and histogram, plus the raw frame times
+  window.getFrameStats().writeJSON(FRAME_STATS_PATH + ".json");
+  window.getFrameStats().writeCSV(FRAME_STATS_PATH + ".csv");
+
+#if defined(CRB_ENABLE_PROFILER)
+  // Open in chrome://tracing or Perfetto
+  crb::Profiler::writeTrace(PROFILER_TRACE_PATH);
+#endif
 
   // Termination
   glfwTerminate();
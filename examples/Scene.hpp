@@ -0,0 +1,171 @@
+#ifndef CRB_EXAMPLES_SCENE_HPP
+#define CRB_EXAMPLES_SCENE_HPP
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <string>
+
+#include "CRobes/Constants.hpp"
+#include "CRobes/Core.hpp"
+#include "CRobes/Color.hpp"
+#include "CRobes/Graphics.hpp"
+#include "CRobes/Window.hpp"
+#include "CRobes/Space.hpp"
+#include "CRobes/Camera.hpp"
+#include "CRobes/Solids.hpp"
+#include "CRobes/ChunkManager.hpp"
+#include "CRobes/ThreadPool.hpp"
+#include "CRobes/GUI.hpp"
+
+// Window Settings
+constexpr unsigned int WINDOW_WIDTH  {800u};
+constexpr unsigned int WINDOW_HEIGHT {600u};
+const     std::string  WINDOW_TITLE  {crb::ENGINE_NAME + " " + crb::ENGINE_VERSION};
+
+// Camera Settings
+constexpr float CAMERA_FOV         {60.f};
+constexpr float CAMERA_NEAR        {0.1f};
+constexpr float CAMERA_FAR         {512.f};
+constexpr float CAMERA_SPEED       {5.f};
+constexpr float CAMERA_SENSITIVITY {0.1};
+
+// Settings
+constexpr unsigned int RENDER_DISTANCE {8};
+constexpr crb::ChunkManager::Storage DEFAULT_CHUNK_STORAGE {crb::ChunkManager::Instances};
+
+// Reads a chunk storage from the command line: solids, instances or arena
+inline bool parseChunkStorage(const std::string& name, crb::ChunkManager::Storage& oStorage)
+{
+  if (name == "solids")
+  { oStorage = crb::ChunkManager::Solids; }
+  else if (name == "instances")
+  { oStorage = crb::ChunkManager::Instances; }
+  else if (name == "arena")
+  { oStorage = crb::ChunkManager::Arena; }
+  else
+  {
+    std::cerr << "Unknown chunk storage (" << name << "), expected solids, instances or arena!\n";
+    return false;
+  }
+  return true;
+}
+
+// Camera Position
+const crb::Space::Vec3 defaultCameraPosition {8.f, 1.8f, 8.f};
+
+// Scene shared by the example and the benchmarks
+class SceneWindow : public crb::Window
+{
+  public:
+    SceneWindow(const unsigned int width, const unsigned int height, const std::string& title, const crb::Window::Mode mode = crb::Window::Windowed, const crb::ChunkManager::Storage chunkStorage = DEFAULT_CHUNK_STORAGE)
+    : crb::Window(width, height, title, mode), chunkStorage(chunkStorage)
+    {}
+
+    ~SceneWindow()
+    {
+      this->defaultShader.Delete();
+      this->instancedShader.Delete();
+      this->guiShader.Delete();
+    }
+
+    void initialize()
+    {
+      // The shaders compiled while the textures were loading
+      this->defaultShader.finish();
+      this->instancedShader.finish();
+      this->guiShader.finish();
+
+      this->bindCamera(this->camera);
+      this->camera.setPosition(defaultCameraPosition);
+      this->chunkManager.update(this->camera.getPosition());
+    }
+
+  protected:
+    void update()
+    {
+      // Played back paths load the same chunks on every run, however fast the workers are
+      this->chunkManager.setBlocking(this->isPlayingBack());
+      this->chunkManager.update(this->camera.getPosition());
+
+      const unsigned int bufferWidth = this->getWidth();
+      const unsigned int bufferHeight = this->getHeight();
+      this->crosshair.setPosition({
+        (float)bufferWidth / 2.f - 8.f,
+        (float)bufferHeight / 2.f - 8.f
+      });
+    }
+
+    void render()
+    {
+      crb::RenderQueue& renderQueue = this->getRenderQueue();
+
+      const std::size_t culledChunks = this->chunkManager.submit(
+        renderQueue,
+        this->terrainShader,
+        &this->soilTexture,
+        GL_TRIANGLE_STRIP,
+        this->camera.getFrustum()
+      );
+      if (culledChunks != this->culledChunks)
+      {
+        this->culledChunks = culledChunks;
+        this->setTitle(WINDOW_TITLE + " | Culled chunks: " + std::to_string(culledChunks) + "/" + std::to_string(this->chunkManager.getChunkCount()));
+      }
+      renderQueue.submit(this->crosshair, this->guiShader, &this->crosshairTexture);
+    }
+
+  protected:
+    crb::ChunkManager::Storage chunkStorage {DEFAULT_CHUNK_STORAGE};
+
+    crb::Graphics::Shader defaultShader
+    {
+      "resources/Shaders/default.vert",
+      "resources/Shaders/default.frag",
+      crb::Graphics::Shader::Deferred
+    };
+    crb::Graphics::Shader instancedShader
+    {
+      "resources/Shaders/instanced.vert",
+      "resources/Shaders/default.frag",
+      crb::Graphics::Shader::Deferred
+    };
+    crb::Graphics::Shader& terrainShader
+    {
+      this->chunkStorage == crb::ChunkManager::Instances ? this->instancedShader : this->defaultShader
+    };
+    crb::Graphics::Shader guiShader
+    {
+      "resources/Shaders/gui.vert",
+      "resources/Shaders/gui.frag",
+      crb::Graphics::Shader::Deferred
+    };
+    crb::Graphics::Texture soilTexture
+    {
+      "resources/Textures/soil.png",
+      GL_TEXTURE_2D
+    };
+    crb::Graphics::Texture crosshairTexture
+    {
+      "resources/Textures/crosshair.png",
+      GL_TEXTURE_2D
+    };
+    crb::Camera camera
+    {
+      CAMERA_FOV,
+      WINDOW_WIDTH,
+      WINDOW_HEIGHT,
+      CAMERA_NEAR,
+      CAMERA_FAR,
+      CAMERA_SPEED,
+      CAMERA_SENSITIVITY
+    };
+    crb::GUI::Element crosshair {
+      {0.f, 0.f}, 0.f, 0.f, 16.f, 16.f
+    };
+    crb::ThreadPool threadPool;
+    crb::ChunkManager chunkManager {RENDER_DISTANCE, threadPool, chunkStorage};
+    std::size_t culledChunks {0u};
+};
+
+#endif // CRB_EXAMPLES_SCENE_HPP
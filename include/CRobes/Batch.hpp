@@ -0,0 +1,257 @@
+#ifndef CRB_BATCH_HPP
+#define CRB_BATCH_HPP
+
+#include <cstddef>
+
+#include "Space.hpp"
+
+namespace crb
+{
+  /**
+   * @brief Contains vectorised kernels operating on large sets of vectors in the Ceremonial Robes Engine.
+   */
+  namespace Batch
+  {
+    /**
+     * @brief The alignment of every component array in bytes.
+     */
+    constexpr std::size_t ALIGNMENT {32u};
+
+    /**
+     * @class Vec3Array
+     * @brief Stores a set of 3D vectors in structure-of-arrays layout.
+     * 
+     * The x, y and z components live in three separate aligned arrays,
+     * so the batch kernels can process several vectors per instruction.
+     */
+    class Vec3Array
+    {
+      public:
+        /**
+         * @brief Default constructor.
+         */
+        Vec3Array()
+        {}
+        /**
+         * @brief Constructs a Vec3Array object holding the specified number of zero vectors.
+         * 
+         * @param size The number of vectors.
+         */
+        explicit Vec3Array(const std::size_t size)
+        { this->resize(size); }
+        /**
+         * @brief Destructor releasing the component arrays.
+         */
+        ~Vec3Array()
+        { this->_release(); }
+        /**
+         * @brief Move constructor for Vec3Array objects.
+         * 
+         * @param other Another Vec3Array object.
+         */
+        Vec3Array(crb::Batch::Vec3Array&& other) noexcept
+        { this->_take(other); }
+        /**
+         * @brief Move assignment operator for Vec3Array objects.
+         * 
+         * @param other Another Vec3Array object.
+         * @return A reference to the assigned object.
+         */
+        crb::Batch::Vec3Array& operator=(crb::Batch::Vec3Array&& other) noexcept
+        {
+          if (this != &other)
+          {
+            this->_release();
+            this->_take(other);
+          }
+          return *this;
+        }
+        Vec3Array(const crb::Batch::Vec3Array& other) = delete;
+        crb::Batch::Vec3Array& operator=(const crb::Batch::Vec3Array& other) = delete;
+
+        /**
+         * @brief Gets the number of vectors in the array.
+         * 
+         * @return The number of vectors.
+         */
+        std::size_t getSize() const
+        { return this->size; }
+        /**
+         * @brief Gets the number of vectors the array can hold without reallocating.
+         * 
+         * @return The capacity of the array.
+         */
+        std::size_t getCapacity() const
+        { return this->capacity; }
+        /**
+         * @brief Gets the array of x components.
+         * 
+         * @return A pointer to the x components.
+         */
+        float* getX()
+        { return this->x; }
+        /**
+         * @brief Gets the array of x components (const version).
+         * 
+         * @return A pointer to the x components.
+         */
+        const float* getX() const
+        { return this->x; }
+        /**
+         * @brief Gets the array of y components.
+         * 
+         * @return A pointer to the y components.
+         */
+        float* getY()
+        { return this->y; }
+        /**
+         * @brief Gets the array of y components (const version).
+         * 
+         * @return A pointer to the y components.
+         */
+        const float* getY() const
+        { return this->y; }
+        /**
+         * @brief Gets the array of z components.
+         * 
+         * @return A pointer to the z components.
+         */
+        float* getZ()
+        { return this->z; }
+        /**
+         * @brief Gets the array of z components (const version).
+         * 
+         * @return A pointer to the z components.
+         */
+        const float* getZ() const
+        { return this->z; }
+
+        /**
+         * @brief Gets a vector from the array.
+         * 
+         * @param index The index of the vector.
+         * @return The vector at the specified index.
+         */
+        crb::Space::Vec3 get(const std::size_t index) const
+        { return {this->x[index], this->y[index], this->z[index]}; }
+        /**
+         * @brief Sets a vector in the array.
+         * 
+         * @param index The index of the vector.
+         * @param vec The new value of the vector.
+         */
+        void set(const std::size_t index, const crb::Space::Vec3& vec)
+        {
+          this->x[index] = vec.x;
+          this->y[index] = vec.y;
+          this->z[index] = vec.z;
+        }
+        /**
+         * @brief Appends a vector to the end of the array.
+         * 
+         * @param vec The vector to append.
+         */
+        void push(const crb::Space::Vec3& vec)
+        {
+          if (this->size == this->capacity)
+          {
+            this->reserve(this->capacity == 0 ? 64u : this->capacity * 2);
+          }
+          this->set(this->size++, vec);
+        }
+
+        /**
+         * @brief Changes the number of vectors in the array.
+         * 
+         * New vectors are initialized to (0, 0, 0).
+         * 
+         * @param size The new number of vectors.
+         */
+        void resize(const std::size_t size);
+        /**
+         * @brief Ensures the array can hold the specified number of vectors without reallocating.
+         * 
+         * @param capacity The number of vectors to reserve space for.
+         */
+        void reserve(const std::size_t capacity);
+        /**
+         * @brief Removes all vectors while keeping the allocated memory.
+         */
+        void clear()
+        { this->size = 0; }
+
+      private:
+        float* x {NULL};
+        float* y {NULL};
+        float* z {NULL};
+
+        std::size_t size     {0u};
+        std::size_t capacity {0u};
+
+        /**
+         * @brief Internal method for releasing the component arrays.
+         */
+        void _release();
+        /**
+         * @brief Internal method for taking over the storage of another array.
+         * 
+         * @param other The array to take the storage from.
+         */
+        void _take(crb::Batch::Vec3Array& other);
+    };
+
+    /**
+     * @brief Transforms every vector of an array by a matrix.
+     * 
+     * Equivalent to `(matrix * vec4(vector, w)).xyz` in the shaders.
+     * 
+     * @param mat The transformation matrix.
+     * @param input The vectors to transform.
+     * @param output The array receiving the transformed vectors. May be the input array.
+     * @param w The w component used for every vector (1 for points, 0 for directions).
+     */
+    void transform(const crb::Space::Mat4& mat, const crb::Batch::Vec3Array& input, crb::Batch::Vec3Array& output, const float w = 1.f);
+    /**
+     * @brief Computes the dot products of two arrays element-wise.
+     * 
+     * @param inputOne The first array.
+     * @param inputTwo The second array, at least as long as the first one.
+     * @param output A buffer receiving one dot product per vector.
+     */
+    void dot(const crb::Batch::Vec3Array& inputOne, const crb::Batch::Vec3Array& inputTwo, float* output);
+    /**
+     * @brief Computes the cross products of two arrays element-wise.
+     * 
+     * @param inputOne The first array.
+     * @param inputTwo The second array, at least as long as the first one.
+     * @param output The array receiving the cross products. May be one of the input arrays.
+     */
+    void cross(const crb::Batch::Vec3Array& inputOne, const crb::Batch::Vec3Array& inputTwo, crb::Batch::Vec3Array& output);
+    /**
+     * @brief Computes the length of every vector of an array.
+     * 
+     * @param input The vectors to measure.
+     * @param output A buffer receiving one length per vector.
+     */
+    void lengthOf(const crb::Batch::Vec3Array& input, float* output);
+    /**
+     * @brief Normalizes every vector of an array.
+     * 
+     * Zero-length vectors are normalized to (0, 0, 0).
+     * 
+     * @param input The vectors to normalize.
+     * @param output The array receiving the normalized vectors. May be the input array.
+     */
+    void normalize(const crb::Batch::Vec3Array& input, crb::Batch::Vec3Array& output);
+    /**
+     * @brief Computes the component-wise minimum and maximum of an array.
+     * 
+     * @param input The vectors to reduce. Must not be empty.
+     * @param oMin A reference receiving the minimum of every component.
+     * @param oMax A reference receiving the maximum of every component.
+     */
+    void bounds(const crb::Batch::Vec3Array& input, crb::Space::Vec3& oMin, crb::Space::Vec3& oMax);
+  }
+}
+
+#endif // CRB_BATCH_HPP
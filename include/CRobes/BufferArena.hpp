@@ -0,0 +1,193 @@
+#ifndef CRB_BUFFER_ARENA_HPP
+#define CRB_BUFFER_ARENA_HPP
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "Graphics.hpp"
+#include "ResourcePool.hpp"
+
+namespace crb
+{
+  namespace Graphics
+  {
+    /**
+     * @class OffsetAllocator
+     * @brief Hands out ranges of a fixed capacity and merges them again once they are freed.
+     *
+     * The allocator only does the bookkeeping, it does not own any memory.
+     */
+    class OffsetAllocator
+    {
+      public:
+        /**
+         * @brief Constructs an OffsetAllocator object with a single free range.
+         *
+         * @param capacity The number of units that can be allocated.
+         */
+        explicit OffsetAllocator(const GLuint capacity)
+        : capacity(capacity), freeSize(capacity)
+        {
+          if (capacity > 0)
+          {
+            this->ranges.emplace(0u, capacity);
+          }
+        }
+
+        /**
+         * @brief Gets the number of units that can be allocated.
+         *
+         * @return The capacity of the allocator.
+         */
+        GLuint getCapacity() const
+        { return this->capacity; }
+        /**
+         * @brief Gets the number of units that are not allocated.
+         *
+         * @return The total size of the free ranges.
+         */
+        GLuint getFreeSize() const
+        { return this->freeSize; }
+        /**
+         * @brief Gets the number of free ranges.
+         *
+         * @return The number of free ranges, one when the free space is not fragmented.
+         */
+        std::size_t getFreeRangeCount() const
+        { return this->ranges.size(); }
+
+        /**
+         * @brief Allocates a range, picking the smallest free range that fits it.
+         *
+         * @param size The number of units to allocate.
+         * @param oOffset The offset of the allocated range.
+         * @return True if the range was allocated, false if no free range is large enough.
+         */
+        bool allocate(const GLuint size, GLuint& oOffset);
+        /**
+         * @brief Frees a range and merges it with its free neighbours.
+         *
+         * @param offset The offset of the range, as returned by allocate().
+         * @param size The size the range was allocated with.
+         */
+        void free(const GLuint offset, const GLuint size);
+
+      private:
+        std::map<GLuint, GLuint> ranges;
+
+        GLuint capacity {0u};
+        GLuint freeSize {0u};
+    };
+
+    /**
+     * @class BufferArena
+     * @brief Sub-allocates meshes from a few large vertex and index buffers.
+     *
+     * Meshes live in pages, each page owning one pooled VAO, VBO and EBO. Every mesh of a page
+     * is drawn by a single glMultiDrawElementsBaseVertex call, so there is no VAO bind per
+     * mesh. Every mesh of an arena shares its vertex layout. Meshes are drawn without a model
+     * matrix, so their vertices must be in world space.
+     */
+    class BufferArena
+    {
+      public:
+        /**
+         * @brief The location of a mesh inside the arena.
+         */
+        struct Allocation
+        {
+          std::size_t page        {0u};
+          GLuint      firstVertex {0u};
+          GLuint      vertexCount {0u};
+          GLuint      firstIndex  {0u};
+          GLuint      indexCount  {0u};
+        };
+
+        /**
+         * @brief Constructs a BufferArena object. Pages are only created once they are needed.
+         *
+         * @param layout The layout of the vertices of every mesh.
+         * @param pageVertexCount The number of vertices per page.
+         * @param pageIndexCount The number of indices per page.
+         */
+        explicit BufferArena(const crb::Graphics::VertexLayout& layout, const GLuint pageVertexCount = 65536u, const GLuint pageIndexCount = 262144u)
+        : layout(layout), pageVertexCount(pageVertexCount), pageIndexCount(pageIndexCount)
+        {}
+        /**
+         * @brief Destructor to release associated OpenGL resources.
+         */
+        ~BufferArena();
+        BufferArena(const crb::Graphics::BufferArena& other) = delete;
+        crb::Graphics::BufferArena& operator=(const crb::Graphics::BufferArena& other) = delete;
+
+        /**
+         * @brief Gets the layout of the vertices.
+         *
+         * @return The vertex layout shared by every mesh.
+         */
+        const crb::Graphics::VertexLayout& getLayout() const
+        { return this->layout; }
+        /**
+         * @brief Gets the number of pages.
+         *
+         * @return The number of pages, which is also the number of draw calls rendering every mesh.
+         */
+        std::size_t getPageCount() const
+        { return this->pages.size(); }
+
+        /**
+         * @brief Uploads a mesh into the first page with enough free space, creating a page if none has.
+         *
+         * @param vertices The vertex data, laid out as described by the layout of the arena.
+         * @param verticesSize The size of the vertex data in bytes.
+         * @param indices An array of GLuint containing index data, relative to the first vertex of the mesh.
+         * @param indicesSize The size of the index data array.
+         * @param oAllocation The location of the uploaded mesh.
+         * @return True if the mesh was uploaded, false if it is larger than a page.
+         */
+        bool allocate(const void* vertices, GLsizeiptr verticesSize, const GLuint indices[], GLsizeiptr indicesSize, crb::Graphics::BufferArena::Allocation& oAllocation);
+        /**
+         * @brief Frees the space of a mesh so that it can be reused by later allocations.
+         *
+         * @param allocation The location of the mesh, as returned by allocate().
+         */
+        void free(const crb::Graphics::BufferArena::Allocation& allocation);
+
+        /**
+         * @brief Renders meshes with one multi-draw call per page.
+         *
+         * @param mode The primitive type to draw.
+         * @param allocations The meshes to draw.
+         * @return The number of draw calls issued.
+         */
+        std::size_t render(GLenum mode, const std::vector<const crb::Graphics::BufferArena::Allocation*>& allocations) const;
+
+      private:
+        struct Page
+        {
+          Page(const crb::Graphics::VertexLayout& layout, const GLuint vertexCount, const GLuint indexCount);
+
+          crb::Graphics::MeshHandle mesh;
+
+          crb::Graphics::OffsetAllocator vertices;
+          crb::Graphics::OffsetAllocator indices;
+
+          // Draw parameters gathered by render()
+          std::vector<GLsizei> counts;
+          std::vector<void*>   offsets;
+          std::vector<GLint>   baseVertices;
+        };
+
+        std::vector<std::unique_ptr<Page>> pages;
+
+        crb::Graphics::VertexLayout layout;
+        GLuint                      pageVertexCount {0u};
+        GLuint                      pageIndexCount  {0u};
+    };
+  }
+}
+
+#endif // CRB_BUFFER_ARENA_HPP
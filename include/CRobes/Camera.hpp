@@ -2,6 +2,8 @@
 #define CRB_CAMERA_HPP
 
 #include <GL/glew.h>
+#include <algorithm>
+#include <cmath>
 
 #include "Graphics.hpp"
 #include "Space.hpp"
@@ -14,6 +16,20 @@ namespace crb
   class Camera
   {
     public:
+      /**
+       * @brief The camera data shared by all shaders through a uniform buffer.
+       * 
+       * Matches the std140 layout of the Camera uniform block declared by the shaders.
+       */
+      struct Block
+      {
+        crb::Space::Mat4 view;
+        crb::Space::Mat4 projection;
+        crb::Space::Mat4 viewProjection;
+        crb::Space::Mat4 guiProjection;
+        crb::Space::Vec4 position;
+      };
+
       /**
        * @brief Constructs a Camera object with the specified parameters.
        * 
@@ -85,6 +101,43 @@ namespace crb
        */
       crb::Space::Vec3 getPosition() const
       { return this->position; }
+      /**
+       * @brief Gets the yaw angle of the camera.
+       * 
+       * @return The yaw angle in degrees.
+       */
+      float getYaw() const
+      { return this->yaw; }
+      /**
+       * @brief Gets the pitch angle of the camera.
+       * 
+       * @return The pitch angle in degrees.
+       */
+      float getPitch() const
+      { return this->pitch; }
+      /**
+       * @brief Gets the combined view-projection matrix of the camera.
+       * 
+       * @return The camera matrix.
+       */
+      crb::Space::Mat4 getMatrix() const
+      { return this->matrix; }
+      /**
+       * @brief Gets the view frustum of the camera.
+       * 
+       * The frustum is taken from the 3D view-projection matrix, regardless of the mode.
+       * 
+       * @return The view frustum of the camera.
+       */
+      const crb::Space::Frustum& getFrustum() const
+      { return this->frustum; }
+      /**
+       * @brief Gets the camera data uploaded to the camera uniform buffer.
+       * 
+       * @return The camera data computed by the last call to updateMatrix().
+       */
+      const crb::Camera::Block& getBlock() const
+      { return this->block; }
 
       /**
        * @brief Sets the field of view angle of the camera.
@@ -128,6 +181,17 @@ namespace crb
        */
       void setMovement(const crb::Space::Vec3& movement)
       { this->movement = movement; }
+      /**
+       * @brief Sets the rotation of the camera.
+       * 
+       * @param yaw The yaw angle in degrees.
+       * @param pitch The pitch angle in degrees, clamped to avoid looking straight up or down.
+       */
+      void setRotation(const float yaw, const float pitch)
+      {
+        this->yaw = std::remainderf(yaw, 360.f);
+        this->pitch = std::min(std::max(pitch, -89.9f), 89.9f);
+      }
 
       /**
        * @brief Sets the camera to use 2D mode.
@@ -153,11 +217,13 @@ namespace crb
        */
       void updateRotation(const std::pair<float, float>& mousePosition);
       /**
-       * @brief Updates the camera's projection matrix.
+       * @brief Updates the camera's matrices, frustum and uniform buffer data.
        */
       void updateMatrix();
       /**
-       * @brief Applies the camera matrix to a shader.
+       * @brief Applies the camera matrix to a shader declaring a cameraMatrix uniform.
+       * 
+       * Shaders reading the Camera uniform block do not need this.
        * 
        * @param shader The shader program to apply the matrix to.
        */
@@ -174,6 +240,8 @@ namespace crb
       float sensitivity  {0.1f};
 
       crb::Space::Mat4 matrix   {1.f};
+      crb::Space::Frustum frustum;
+      crb::Camera::Block block;
       crb::Space::Vec3 position {0.f};
       crb::Space::Vec3 front    {0.f, 0.f, -1.f};
       crb::Space::Vec3 up       {0.f, 1.f, 0.f};
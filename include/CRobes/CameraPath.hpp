@@ -0,0 +1,109 @@
+#ifndef CRB_CAMERA_PATH_HPP
+#define CRB_CAMERA_PATH_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Camera.hpp"
+#include "File.hpp"
+#include "Space.hpp"
+
+namespace crb
+{
+  /**
+   * @class CameraPath
+   * @brief Records the camera of every frame, so that a session can be played back exactly.
+   *
+   * Only the resulting camera state is kept, not the inputs that produced it. Playback sets
+   * the camera state directly and advances the simulation by a fixed timestep, so it does
+   * not depend on the frame rate of the machine.
+   */
+  class CameraPath
+  {
+    public:
+      /**
+       * @brief The state of the camera during one frame.
+       */
+      struct Frame
+      {
+        crb::Space::Vec3 position {0.f};
+        float            yaw      {0.f};
+        float            pitch    {0.f};
+        float            fov      {0.f};
+      };
+
+      /**
+       * @brief Constructs an empty CameraPath object.
+       *
+       * @param timestep The time every frame advances the simulation by during playback, in seconds.
+       */
+      explicit CameraPath(const float timestep = 1.f / 60.f)
+      : timestep(timestep)
+      {}
+
+      /**
+       * @brief Gets the number of recorded frames.
+       *
+       * @return The number of frames.
+       */
+      std::size_t getFrameCount() const
+      { return this->frames.size(); }
+      /**
+       * @brief Gets a recorded frame.
+       *
+       * @param index The index of the frame.
+       * @return The frame.
+       */
+      const crb::CameraPath::Frame& getFrame(const std::size_t index) const
+      { return this->frames[index]; }
+      /**
+       * @brief Gets the fixed timestep of playback.
+       *
+       * @return The time every frame advances the simulation by, in seconds.
+       */
+      float getTimestep() const
+      { return this->timestep; }
+
+      /**
+       * @brief Appends the current state of a camera.
+       *
+       * @param camera The camera.
+       */
+      void record(const crb::Camera& camera);
+      /**
+       * @brief Sets a camera to the state of a recorded frame. The matrices still have to be updated.
+       *
+       * @param index The index of the frame.
+       * @param camera The camera.
+       */
+      void apply(const std::size_t index, crb::Camera& camera) const;
+      /**
+       * @brief Discards every recorded frame.
+       */
+      void clear()
+      { this->frames.clear(); }
+
+      /**
+       * @brief Writes the path to a binary file.
+       *
+       * @param path The path to the file.
+       * @return True if the file was written, false otherwise.
+       */
+      bool save(const std::string& path) const;
+      /**
+       * @brief Replaces the frames and the timestep with the ones of a binary file.
+       *
+       * @param path The path to the file, as written by save().
+       * @return True if the file was read, false otherwise.
+       */
+      bool load(const std::string& path);
+
+    private:
+      std::vector<crb::CameraPath::Frame> frames;
+
+      float timestep {1.f / 60.f};
+  };
+}
+
+#endif // CRB_CAMERA_PATH_HPP
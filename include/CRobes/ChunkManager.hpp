@@ -0,0 +1,329 @@
+#ifndef CRB_CHUNK_MANAGER_HPP
+#define CRB_CHUNK_MANAGER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "BufferArena.hpp"
+#include "Constants.hpp"
+#include "DeletionQueue.hpp"
+#include "MeshCache.hpp"
+#include "RenderQueue.hpp"
+#include "Space.hpp"
+#include "Solids.hpp"
+#include "ThreadPool.hpp"
+
+namespace crb
+{
+  /**
+   * @class ChunkManager
+   * @brief Keeps the square of chunks around the camera resident.
+   * 
+   * Resident chunks are stored in a hash map keyed by their chunk coordinates.
+   * The set is only recomputed when the camera crosses a chunk boundary, and
+   * then only the strips of chunks that entered or left the square are touched.
+   * 
+   * With Solids storage, every chunk is a solid drawn on its own, and all of them
+   * share one mesh through a mesh cache. On a cache miss, the mesh is generated on
+   * the thread pool, and the chunks requested meanwhile are created once it is
+   * uploaded. With Instances storage, all chunks share one mesh and the visible ones
+   * are drawn with a single instanced draw call. With Arena storage, chunk meshes
+   * are generated in world space on the thread pool into a shared buffer arena drawn
+   * with one multi-draw call per page. Generated meshes are uploaded on the render
+   * thread during update(), within a per-frame time budget.
+   * 
+   * Evicted chunks keep their GPU storage until the frames drawing them are
+   * finished. Their buffers are then reused by the chunks loaded next.
+   */
+  class ChunkManager
+  {
+    public:
+      /**
+       * @brief Chunk coordinates as returned by crb::Space::getChunkX and crb::Space::getChunkZ.
+       */
+      using Key = std::pair<int, int>;
+
+      /**
+       * @brief How the resident chunks are stored and drawn.
+       */
+      enum Storage
+      {
+        Solids,
+        Instances,
+        Arena,
+      };
+
+      /**
+       * @brief Hash function for chunk coordinates.
+       */
+      struct KeyHash
+      {
+        std::size_t operator()(const crb::ChunkManager::Key& key) const
+        { return std::hash<uint64_t>()(((uint64_t)(uint32_t)key.first << 32) | (uint32_t)key.second); }
+      };
+
+      /**
+       * @brief Constructs a ChunkManager object.
+       * 
+       * @param renderDistance The render distance in chunks. The resident square spans
+       * `renderDistance * 2 - 1` chunks along each axis.
+       * @param threadPool The thread pool generating the chunk meshes. Must outlive the pending jobs.
+       * @param storage How the resident chunks are stored and drawn.
+       */
+      ChunkManager(const unsigned int renderDistance, crb::ThreadPool& threadPool, const crb::ChunkManager::Storage storage = crb::ChunkManager::Solids)
+      : renderDistance(renderDistance), storage(storage), threadPool(threadPool), inbox(std::make_shared<crb::ChunkManager::Inbox>())
+      {
+        const std::size_t side = renderDistance * 2 - 1;
+        this->chunks.reserve(side * side);
+        this->pending.reserve(side * side);
+        this->instances.reserve(side * side);
+      }
+
+      /**
+       * @brief Gets the render distance in chunks.
+       * 
+       * @return The render distance.
+       */
+      unsigned int getRenderDistance() const
+      { return this->renderDistance; }
+      /**
+       * @brief Gets the queue releasing the storage of evicted chunks.
+       * 
+       * @return The deletion queue, which also pools the buffers of evicted chunks.
+       */
+      const crb::Graphics::DeletionQueue& getDeletionQueue() const
+      { return this->deletionQueue; }
+      /**
+       * @brief Gets the cache sharing the mesh of the chunks with Solids storage.
+       * 
+       * @return The mesh cache.
+       */
+      const crb::Solids::MeshCache& getMeshCache() const
+      { return this->meshCache; }
+      /**
+       * @brief Gets how the resident chunks are stored and drawn.
+       * 
+       * @return The storage of the chunks.
+       */
+      crb::ChunkManager::Storage getStorage() const
+      { return this->storage; }
+      /**
+       * @brief Gets the resident chunks owning their mesh.
+       * 
+       * Empty unless the storage is Solids.
+       * 
+       * @return The map of resident chunks keyed by their chunk coordinates.
+       */
+      const std::unordered_map<crb::ChunkManager::Key, crb::Solids::Solid, crb::ChunkManager::KeyHash>& getChunks() const
+      { return this->chunks; }
+      /**
+       * @brief Gets the number of resident chunks.
+       * 
+       * @return The number of resident chunks.
+       */
+      std::size_t getChunkCount() const
+      { return this->chunks.size() + this->instances.size() + this->arenaChunks.size(); }
+      /**
+       * @brief Checks whether a chunk is resident.
+       * 
+       * @param key The chunk coordinates.
+       * @return True if the chunk is resident, false otherwise.
+       */
+      bool hasChunk(const crb::ChunkManager::Key& key) const
+      {
+        return this->chunks.find(key) != this->chunks.end()
+          || this->instances.find(key) != this->instances.end()
+          || this->arenaChunks.find(key) != this->arenaChunks.end();
+      }
+      /**
+       * @brief Gets the number of chunks whose meshes are still being generated or waiting for upload.
+       * 
+       * @return The number of pending chunks.
+       */
+      std::size_t getPendingCount() const
+      { return this->pending.size(); }
+      /**
+       * @brief Gets the time per frame that may be spent uploading finished chunk meshes.
+       * 
+       * @return The upload budget in milliseconds.
+       */
+      float getUploadBudget() const
+      { return this->uploadBudget; }
+
+      /**
+       * @brief Sets the time per frame that may be spent uploading finished chunk meshes.
+       * 
+       * At least one mesh is uploaded per frame so streaming always makes progress.
+       * 
+       * @param milliseconds The upload budget in milliseconds.
+       */
+      void setUploadBudget(const float milliseconds)
+      { this->uploadBudget = milliseconds; }
+      /**
+       * @brief Checks whether update() waits for every requested chunk.
+       * 
+       * @return True if chunks are loaded synchronously, false if they stream in over several frames.
+       */
+      bool isBlocking() const
+      { return this->blocking; }
+      /**
+       * @brief Sets whether update() waits for every requested chunk and uploads it, regardless of the upload budget.
+       * 
+       * The resident chunks then only depend on the camera positions seen so far, not on
+       * how fast the worker threads are, which reproducible playback needs.
+       * 
+       * @param blocking True to load chunks synchronously, false to stream them in.
+       */
+      void setBlocking(const bool blocking)
+      { this->blocking = blocking; }
+
+      /**
+       * @brief Updates the resident chunks for the current camera position.
+       * 
+       * Requests and evicts chunks only if the camera entered a different chunk since
+       * the last call, then uploads finished meshes within the upload budget. When
+       * blocking, waits for every pending chunk and uploads all of them instead. Meant to
+       * be called once per frame, since it also releases the storage of evicted chunks.
+       * 
+       * @param cameraPosition The position of the camera.
+       * @return True if chunks were requested, evicted or uploaded, false otherwise.
+       */
+      bool update(const crb::Space::Vec3& cameraPosition);
+      /**
+       * @brief Collects the resident chunks that are at least partially inside a view frustum.
+       * 
+       * @param frustum The view frustum to test against.
+       * @param oVisible A vector that is filled with pointers to the visible chunks.
+       * @return The number of chunks that were culled.
+       */
+      std::size_t cull(const crb::Space::Frustum& frustum, std::vector<const crb::Solids::Solid*>& oVisible) const;
+      /**
+       * @brief Renders the resident chunks that are at least partially inside a view frustum.
+       * 
+       * @param shader The shader program to use for rendering. Must be the instanced shader with Instances storage.
+       * @param mode The primitive type to draw.
+       * @param frustum The view frustum to test against.
+       * @return The number of chunks that were culled.
+       */
+      std::size_t render(const crb::Graphics::Shader& shader, GLenum mode, const crb::Space::Frustum& frustum);
+      /**
+       * @brief Queues the resident chunks that are at least partially inside a view frustum.
+       * 
+       * With Instances or Arena storage, all visible chunks are queued as a single item.
+       * 
+       * @param queue The render queue to submit to. Must be flushed before the chunks change.
+       * @param shader The shader program to use for rendering. Must be the instanced shader with Instances storage.
+       * @param texture The texture bound to unit 0, or NULL.
+       * @param mode The primitive type to draw.
+       * @param frustum The view frustum to test against.
+       * @return The number of chunks that were culled.
+       */
+      std::size_t submit(crb::RenderQueue& queue, const crb::Graphics::Shader& shader, const crb::Graphics::Texture* texture, GLenum mode, const crb::Space::Frustum& frustum);
+
+    private:
+      /**
+       * @brief Finished meshes handed from the worker threads to the render thread.
+       * 
+       * Shared with the jobs, so it stays alive while jobs are running.
+       */
+      struct Inbox
+      {
+        std::mutex              mutex;
+        std::condition_variable delivered;
+        std::vector<std::pair<crb::ChunkManager::Key, crb::Solids::Mesh>> meshes;
+      };
+      /**
+       * @brief A chunk uploaded into the buffer arena.
+       */
+      struct ArenaChunk
+      {
+        crb::Graphics::BufferArena::Allocation allocation;
+        crb::Space::AABB                       bounds;
+      };
+
+      unsigned int               renderDistance {1u};
+      crb::ChunkManager::Storage storage        {crb::ChunkManager::Solids};
+      float                      uploadBudget   {2.f};
+
+      crb::ThreadPool&                         threadPool;
+      std::shared_ptr<crb::ChunkManager::Inbox> inbox;
+      std::vector<std::pair<crb::ChunkManager::Key, crb::Solids::Mesh>> finished;
+
+      // Declared before the chunks, which release their buffers and arena space into it
+      crb::Graphics::BufferArena    arena {crb::Solids::VertexFormat::LAYOUT};
+      crb::Graphics::DeletionQueue deletionQueue;
+      crb::Solids::MeshCache       meshCache {&this->deletionQueue};
+
+      std::unordered_map<crb::ChunkManager::Key, crb::Solids::Solid, crb::ChunkManager::KeyHash> chunks;
+      std::unordered_set<crb::ChunkManager::Key, crb::ChunkManager::KeyHash>                     pending;
+      std::unordered_set<crb::ChunkManager::Key, crb::ChunkManager::KeyHash>                     instances;
+      std::unordered_map<crb::ChunkManager::Key, crb::ChunkManager::ArenaChunk, crb::ChunkManager::KeyHash> arenaChunks;
+
+      std::unique_ptr<crb::Solids::InstancedSolid> sharedMesh;
+      std::vector<const crb::Solids::Solid*>       visibleChunks;
+      std::vector<crb::Space::Vec3>                visibleOffsets;
+
+      std::vector<const crb::Graphics::BufferArena::Allocation*> visibleAllocations;
+
+      crb::ChunkManager::Key center {0, 0};
+      bool initialized    {false};
+      bool blocking       {false};
+      bool planeRequested {false};
+
+      /**
+       * @brief Internal method for creating a chunk, or requesting its mesh from the thread pool.
+       * 
+       * @param key The chunk coordinates.
+       */
+      void _request(const crb::ChunkManager::Key& key);
+      /**
+       * @brief Internal method for uploading finished meshes within the upload budget.
+       * 
+       * @return True if at least one chunk was uploaded, false otherwise.
+       */
+      bool _upload();
+      /**
+       * @brief Internal method for waiting until every pending chunk is generated, and uploading it.
+       * 
+       * @return True if at least one chunk was uploaded, false otherwise.
+       */
+      bool _drain();
+      /**
+       * @brief Internal method for uploading the shared mesh of Solids storage and creating the chunks waiting for it.
+       * 
+       * @param mesh The generated mesh.
+       * @return True if chunks were created, false if every waiting chunk was evicted.
+       */
+      bool _uploadPlane(const crb::Solids::Mesh& mesh);
+      /**
+       * @brief Internal method for freeing the arena space of a chunk.
+       * 
+       * @param key The chunk coordinates.
+       */
+      void _evictArenaChunk(const crb::ChunkManager::Key& key);
+      /**
+       * @brief Internal method for culling the resident chunks and preparing the visible ones for drawing.
+       * 
+       * @param frustum The view frustum to test against.
+       * @return The number of chunks that were culled.
+       */
+      std::size_t _collect(const crb::Space::Frustum& frustum);
+      /**
+       * @brief Internal method for drawing the visible chunks of the buffer arena.
+       * 
+       * @param object The chunk manager.
+       * @param shader The shader program in use.
+       * @param mode The primitive type to draw.
+       */
+      static void _drawArena(const void* object, const crb::Graphics::Shader& shader, GLenum mode);
+  };
+}
+
+#endif // CRB_CHUNK_MANAGER_HPP
@@ -27,6 +27,20 @@ namespace crb
    */
   inline const unsigned int INFO_LOG_SIZE {512u};
 
+  /**
+   * @brief The name of the uniform block holding the camera data.
+   */
+  inline const std::string CAMERA_BLOCK_NAME {"Camera"};
+  /**
+   * @brief The uniform buffer binding point of the camera data.
+   */
+  constexpr unsigned int CAMERA_BLOCK_BINDING {0u};
+
+  /**
+   * @brief The index restarting strip and fan primitives. Being the largest 32-bit index, it never collides with a vertex.
+   */
+  constexpr unsigned int PRIMITIVE_RESTART_INDEX {0xFFFFFFFFu};
+
   /**
    * @brief The size of each chunk.
    */
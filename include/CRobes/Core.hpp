@@ -25,10 +25,15 @@ namespace crb
 
     /**
      * @brief Initializes GLFW.
+     *
+     * @param headless Whether to use the null platform of GLFW, which needs no display server. Only headless windows can be created then.
      */
-    void initializeGlfw();
+    void initializeGlfw(const bool headless = false);
     /**
      * @brief Initializes GLEW.
+     *
+     * A context without GLX, such as a headless EGL context, is accepted, as the OpenGL
+     * entry points are loaded before GLX is checked.
      */
     void initializeGlew();
   }
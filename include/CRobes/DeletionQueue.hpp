@@ -0,0 +1,175 @@
+#ifndef CRB_DELETION_QUEUE_HPP
+#define CRB_DELETION_QUEUE_HPP
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "State.hpp"
+#include "VertexLayout.hpp"
+
+namespace crb
+{
+  namespace Graphics
+  {
+    /**
+     * @brief The vertex array object and buffers of a single indexed mesh.
+     */
+    struct MeshBuffers
+    {
+      GLuint     vertexArray  {0u};
+      GLuint     vertexBuffer {0u};
+      GLuint     indexBuffer  {0u};
+      GLsizeiptr verticesSize {0};
+      GLsizeiptr indicesSize  {0};
+
+      // The layout the vertex array object was linked with
+      const crb::Graphics::VertexLayout* layout {NULL};
+    };
+
+    /**
+     * @brief Creates the buffers of a mesh and links the attributes of the vertex layout.
+     *
+     * @param layout The layout of the vertices. Must outlive the buffers.
+     * @param verticesSize The size of the vertex buffer in bytes.
+     * @param indicesSize The size of the index buffer in bytes.
+     * @param usage The expected usage of the buffers.
+     * @return The created buffers, with uninitialized contents.
+     */
+    crb::Graphics::MeshBuffers createMeshBuffers(const crb::Graphics::VertexLayout& layout, const GLsizeiptr verticesSize, const GLsizeiptr indicesSize, const GLenum usage = GL_STATIC_DRAW);
+    /**
+     * @brief Replaces the contents of the buffers of a mesh.
+     *
+     * @param buffers The buffers of the mesh.
+     * @param vertices The vertex data, at most as large as the vertex buffer.
+     * @param verticesSize The size of the vertex data in bytes.
+     * @param indices The index data, at most as large as the index buffer.
+     * @param indicesSize The size of the index data in bytes.
+     */
+    void uploadMeshBuffers(const crb::Graphics::MeshBuffers& buffers, const void* vertices, const GLsizeiptr verticesSize, const GLuint indices[], const GLsizeiptr indicesSize);
+    /**
+     * @brief Deletes the buffers of a mesh right away.
+     *
+     * @param buffers The buffers to delete, reset to zero afterwards.
+     */
+    void deleteMeshBuffers(crb::Graphics::MeshBuffers& buffers);
+
+    /**
+     * @class DeletionQueue
+     * @brief Delays the deletion of OpenGL objects until the GPU has finished the frames using them.
+     *
+     * Objects released during a frame are tagged with a fence by collect(), and are only
+     * deleted once a later collect() finds the fence signaled, so deleting never makes
+     * the driver wait for in-flight frames. Released mesh buffers are kept in a pool
+     * instead, so that a mesh of the same layout and size can reuse them without
+     * allocating new storage.
+     */
+    class DeletionQueue
+    {
+      public:
+        /**
+         * @brief Constructs a DeletionQueue object.
+         *
+         * @param poolCapacity The maximum number of mesh buffers kept for reuse.
+         */
+        explicit DeletionQueue(const std::size_t poolCapacity = 64u)
+        : poolCapacity(poolCapacity)
+        {}
+        /**
+         * @brief Destructor deleting every queued and pooled object right away.
+         */
+        ~DeletionQueue();
+        DeletionQueue(const crb::Graphics::DeletionQueue& other) = delete;
+        crb::Graphics::DeletionQueue& operator=(const crb::Graphics::DeletionQueue& other) = delete;
+
+        /**
+         * @brief Gets the number of released objects the GPU may still use.
+         *
+         * @return The number of queued deletions.
+         */
+        std::size_t getPendingCount() const
+        {
+          std::size_t count = this->current.size();
+          for (const Batch& batch : this->batches)
+          {
+            count += batch.actions.size();
+          }
+          return count;
+        }
+        /**
+         * @brief Gets the number of mesh buffers available for reuse.
+         *
+         * @return The number of pooled mesh buffers.
+         */
+        std::size_t getPooledCount() const
+        { return this->pool.size(); }
+        /**
+         * @brief Gets the number of meshes that reused pooled buffers.
+         *
+         * @return The number of successful reuse() calls.
+         */
+        std::size_t getReusedCount() const
+        { return this->reusedCount; }
+
+        /**
+         * @brief Runs an action once the GPU has finished every command submitted so far.
+         *
+         * @param action The action, typically deleting an object.
+         */
+        void defer(std::function<void()> action)
+        { this->current.push_back(std::move(action)); }
+        /**
+         * @brief Deletes a buffer once the GPU no longer uses it.
+         *
+         * @param buffer The OpenGL ID of the buffer.
+         */
+        void deleteBuffer(const GLuint buffer);
+        /**
+         * @brief Deletes a vertex array object once the GPU no longer uses it.
+         *
+         * @param vertexArray The OpenGL ID of the vertex array object.
+         */
+        void deleteVertexArray(const GLuint vertexArray);
+        /**
+         * @brief Adds the buffers of a mesh to the pool once the GPU no longer uses them.
+         *
+         * @param buffers The buffers of the mesh.
+         */
+        void recycle(const crb::Graphics::MeshBuffers& buffers);
+        /**
+         * @brief Takes the smallest pooled buffers of a layout that can hold a mesh.
+         *
+         * @param layout The layout of the vertices.
+         * @param verticesSize The size of the vertex data in bytes.
+         * @param indicesSize The size of the index data in bytes.
+         * @param oBuffers The pooled buffers, removed from the pool.
+         * @return True if pooled buffers were found, false otherwise.
+         */
+        bool reuse(const crb::Graphics::VertexLayout& layout, const GLsizeiptr verticesSize, const GLsizeiptr indicesSize, crb::Graphics::MeshBuffers& oBuffers);
+        /**
+         * @brief Fences the objects released since the last call, and deletes the ones the GPU is done with.
+         *
+         * Meant to be called once per frame. Never waits for the GPU.
+         */
+        void collect();
+
+      private:
+        struct Batch
+        {
+          GLsync                             fence {NULL};
+          std::vector<std::function<void()>> actions;
+        };
+
+        std::deque<Batch>                  batches;
+        std::vector<std::function<void()>> current;
+
+        std::vector<crb::Graphics::MeshBuffers> pool;
+        std::size_t                             poolCapacity {64u};
+        std::size_t                             reusedCount  {0u};
+    };
+  }
+}
+
+#endif // CRB_DELETION_QUEUE_HPP
@@ -5,6 +5,7 @@
 #include <sstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
 namespace crb
 {
@@ -20,6 +21,25 @@ namespace crb
      * @return The contents of the file as a string.
      */
     std::string getContents(const std::string& path);
+    /**
+     * @brief Reads the contents of a binary file.
+     *
+     * Does not report missing files, so it can be used to probe caches.
+     *
+     * @param path The path to the file.
+     * @param oContents A vector that is filled with the bytes of the file.
+     * @return True if the file was read, false otherwise.
+     */
+    bool getBinaryContents(const std::string& path, std::vector<char>& oContents);
+    /**
+     * @brief Writes a binary file, creating its parent directories if needed.
+     *
+     * @param path The path to the file.
+     * @param data The bytes to write.
+     * @param size The number of bytes to write.
+     * @return True if the file was written, false otherwise.
+     */
+    bool setBinaryContents(const std::string& path, const void* data, std::size_t size);
   }
 }
 
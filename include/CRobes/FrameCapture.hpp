@@ -0,0 +1,146 @@
+#ifndef CRB_FRAME_CAPTURE_HPP
+#define CRB_FRAME_CAPTURE_HPP
+
+#include <GL/glew.h>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+
+#include "Image.hpp"
+#include "State.hpp"
+#include "ThreadPool.hpp"
+
+namespace crb
+{
+  /**
+   * @class FrameCapture
+   * @brief Saves frames to PNG files without stalling the render loop.
+   *
+   * Frames are read into a ring of pixel buffer objects, and only mapped once a fence
+   * shows that the GPU has written them, a few frames later. Encoding and writing the
+   * PNG file happens on a worker thread. When every buffer or the encoder is still busy,
+   * the capture is dropped rather than waited for.
+   */
+  class FrameCapture
+  {
+    public:
+      /**
+       * @brief The number of frames that can be read back at the same time.
+       */
+      static constexpr std::size_t RING_SIZE {3u};
+      /**
+       * @brief The number of frames that can wait for the encoder.
+       */
+      static constexpr std::size_t MAX_PENDING_ENCODES {4u};
+
+      /**
+       * @brief Constructs a FrameCapture object. Buffers are only created once they are needed.
+       */
+      FrameCapture()
+      : encoder(1u)
+      {}
+      /**
+       * @brief Destructor that waits for every pending capture and releases associated OpenGL resources.
+       */
+      ~FrameCapture();
+      FrameCapture(const crb::FrameCapture& other) = delete;
+      crb::FrameCapture& operator=(const crb::FrameCapture& other) = delete;
+
+      /**
+       * @brief Gets the number of frames written to files.
+       *
+       * @return The number of written captures.
+       */
+      std::size_t getWrittenCount()
+      {
+        std::lock_guard<std::mutex> lock {this->mutex};
+        return this->writtenCaptures;
+      }
+      /**
+       * @brief Gets the number of captures dropped because the readback or the encoder was busy.
+       *
+       * @return The number of dropped captures.
+       */
+      std::size_t getDroppedCount()
+      {
+        std::lock_guard<std::mutex> lock {this->mutex};
+        return this->droppedCaptures;
+      }
+
+      /**
+       * @brief Captures the next frame.
+       *
+       * @param path The path to the PNG file.
+       */
+      void request(const std::string& path)
+      { this->requests.push_back(path); }
+      /**
+       * @brief Captures frames periodically.
+       *
+       * @param frames The number of frames between captures, 0 to stop capturing periodically.
+       * @param prefix The path of the files, completed with the frame number and ".png".
+       */
+      void setInterval(const std::size_t frames, const std::string& prefix)
+      {
+        this->interval = frames;
+        this->prefix = prefix;
+      }
+
+      /**
+       * @brief Ends a frame, reading it back if it is captured, and hands finished readbacks to the encoder.
+       *
+       * @param framebuffer The framebuffer to read, 0 for the back buffer of the window.
+       * @param width The width of the framebuffer.
+       * @param height The height of the framebuffer.
+       */
+      void capture(const GLuint framebuffer, const unsigned int width, const unsigned int height);
+      /**
+       * @brief Hands finished readbacks to the encoder without waiting for the GPU.
+       */
+      void poll();
+      /**
+       * @brief Waits until every pending capture is written.
+       */
+      void finish();
+
+    private:
+      struct Slot
+      {
+        GLuint       buffer {0u};
+        GLsizeiptr   size   {0};
+        GLsync       fence  {NULL};
+        unsigned int width  {0u};
+        unsigned int height {0u};
+        std::string  path;
+      };
+
+      /**
+       * @brief Internal method for copying a finished readback and queueing it for encoding.
+       *
+       * @param slot The slot holding the readback.
+       * @param wait Whether to wait for room in the encoder queue rather than dropping the capture.
+       */
+      void _encode(crb::FrameCapture::Slot& slot, const bool wait);
+
+      crb::FrameCapture::Slot slots[RING_SIZE];
+      std::size_t             nextSlot {0u};
+
+      std::deque<std::string> requests;
+      std::string             prefix;
+      std::size_t             interval {0u};
+      std::size_t             frame    {0u};
+
+      std::mutex              mutex;
+      std::condition_variable encoded;
+      std::size_t             pendingEncodes  {0u};
+      std::size_t             writtenCaptures {0u};
+      std::size_t             droppedCaptures {0u};
+
+      // Declared last, so that its worker stops before the members it uses are destroyed
+      crb::ThreadPool encoder;
+  };
+}
+
+#endif // CRB_FRAME_CAPTURE_HPP
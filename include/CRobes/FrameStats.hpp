@@ -0,0 +1,168 @@
+#ifndef CRB_FRAME_STATS_HPP
+#define CRB_FRAME_STATS_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace crb
+{
+  /**
+   * @class FrameStats
+   * @brief Keeps rolling statistics about frame times.
+   *
+   * The latest frame times are kept in a ring buffer, from which summaries over any
+   * number of recent frames can be computed. The histogram and the count of frames
+   * that missed the target cover every recorded frame.
+   */
+  class FrameStats
+  {
+    public:
+      /**
+       * @brief The number of histogram buckets per doubling of the frame time.
+       */
+      static constexpr std::size_t BUCKETS_PER_OCTAVE {4u};
+      /**
+       * @brief The number of histogram buckets.
+       */
+      static constexpr std::size_t BUCKET_COUNT {56u};
+      /**
+       * @brief The upper bound of the first histogram bucket, in milliseconds.
+       */
+      static constexpr double HISTOGRAM_START {0.125};
+
+      /**
+       * @brief Statistics over a number of frames, in milliseconds.
+       */
+      struct Summary
+      {
+        std::size_t frames {0u};
+        std::size_t missed {0u};
+        double      min    {0.0};
+        double      max    {0.0};
+        double      mean   {0.0};
+        double      p50    {0.0};
+        double      p95    {0.0};
+        double      p99    {0.0};
+        double      p999   {0.0};
+      };
+
+      /**
+       * @brief Constructs a FrameStats object.
+       *
+       * @param capacity The number of frames kept for summaries.
+       * @param targetMilliseconds The frame time above which a frame missed the target.
+       */
+      FrameStats(const std::size_t capacity = 3600u, const double targetMilliseconds = 1000.0 / 60.0)
+      : frameTimes(capacity > 0 ? capacity : 1u), histogram(BUCKET_COUNT, 0u), targetMilliseconds(targetMilliseconds)
+      {}
+
+      /**
+       * @brief Gets the number of frames kept for summaries.
+       *
+       * @return The capacity of the ring buffer.
+       */
+      std::size_t getCapacity() const
+      { return this->frameTimes.size(); }
+      /**
+       * @brief Gets the number of recorded frames.
+       *
+       * @return The number of frames recorded since the statistics were created or reset.
+       */
+      std::size_t getFrameCount() const
+      { return this->frameCount; }
+      /**
+       * @brief Gets the number of recorded frames that took longer than the target.
+       *
+       * @return The number of missed frames.
+       */
+      std::size_t getMissedFrameCount() const
+      { return this->missedFrames; }
+      /**
+       * @brief Gets the target frame time.
+       *
+       * @return The target frame time, in milliseconds.
+       */
+      double getTargetMilliseconds() const
+      { return this->targetMilliseconds; }
+      /**
+       * @brief Gets the log-scale histogram of every recorded frame.
+       *
+       * Bucket 0 counts frames up to HISTOGRAM_START, and every following bucket is
+       * 2^(1/BUCKETS_PER_OCTAVE) times wider than the previous one. The last bucket
+       * also counts every longer frame.
+       *
+       * @return The number of frames per bucket.
+       */
+      const std::vector<std::size_t>& getHistogram() const
+      { return this->histogram; }
+
+      /**
+       * @brief Sets the target frame time. Frames recorded earlier are not counted again.
+       *
+       * @param targetMilliseconds The frame time above which a frame missed the target.
+       */
+      void setTargetMilliseconds(const double targetMilliseconds)
+      { this->targetMilliseconds = targetMilliseconds; }
+
+      /**
+       * @brief Gets the upper bound of a histogram bucket.
+       *
+       * @param bucket The index of the bucket.
+       * @return The longest frame time counted by the bucket, in milliseconds.
+       */
+      static double getBucketLimit(const std::size_t bucket);
+
+      /**
+       * @brief Records the time of a frame.
+       *
+       * @param milliseconds The frame time, in milliseconds.
+       */
+      void record(const double milliseconds);
+      /**
+       * @brief Discards every recorded frame.
+       */
+      void reset();
+      /**
+       * @brief Computes statistics over the latest frames.
+       *
+       * @param frames The number of frames to summarize, clamped to the number of kept frames. 0 summarizes every kept frame.
+       * @return The statistics of the frames.
+       */
+      crb::FrameStats::Summary getSummary(const std::size_t frames = 0u) const;
+
+      /**
+       * @brief Writes the summary of every kept frame and the histogram as JSON.
+       *
+       * @param path The path to the file.
+       * @return True if the file was written, false otherwise.
+       */
+      bool writeJSON(const std::string& path) const;
+      /**
+       * @brief Writes the kept frame times as CSV, one frame per row, oldest first.
+       *
+       * @param path The path to the file.
+       * @return True if the file was written, false otherwise.
+       */
+      bool writeCSV(const std::string& path) const;
+
+    private:
+      /**
+       * @brief Internal method for copying the latest frame times, oldest first.
+       *
+       * @param frames The number of frames to copy, at most the number of kept frames.
+       * @param oFrameTimes The copied frame times.
+       */
+      void _copyLatest(const std::size_t frames, std::vector<double>& oFrameTimes) const;
+
+      std::vector<double>      frameTimes;
+      std::vector<std::size_t> histogram;
+
+      std::size_t frameCount   {0u};
+      std::size_t missedFrames {0u};
+
+      double targetMilliseconds {1000.0 / 60.0};
+  };
+}
+
+#endif // CRB_FRAME_STATS_HPP
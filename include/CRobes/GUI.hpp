@@ -2,6 +2,7 @@
 #define CRB_GUI_HPP
 
 #include "Graphics.hpp"
+#include "ResourcePool.hpp"
 #include "Space.hpp"
 
 namespace crb
@@ -18,6 +19,38 @@ namespace crb
     {
       public:
         Element(const crb::Space::Vec2& position, const float x, const float y, const float width, const float height);
+        /**
+         * @brief Destructor to release associated OpenGL resources.
+         */
+        ~Element()
+        { crb::Graphics::destroyMesh(this->mesh); }
+        /**
+         * @brief Move constructor for Element objects.
+         *
+         * @param other Another Element object.
+         */
+        Element(crb::GUI::Element&& other) noexcept
+        : mesh(other.mesh), position(other.position)
+        { other.mesh = {}; }
+        /**
+         * @brief Move assignment operator for Element objects.
+         *
+         * @param other Another Element object.
+         * @return A reference to the assigned object.
+         */
+        crb::GUI::Element& operator=(crb::GUI::Element&& other) noexcept
+        {
+          if (this != &other)
+          {
+            crb::Graphics::destroyMesh(this->mesh);
+            this->mesh = other.mesh;
+            this->position = other.position;
+            other.mesh = {};
+          }
+          return *this;
+        }
+        Element(const crb::GUI::Element& other) = delete;
+        crb::GUI::Element& operator=(const crb::GUI::Element& other) = delete;
 
         /**
          * @brief Sets the position of the element in 2D space.
@@ -27,6 +60,17 @@ namespace crb
         void setPosition(const crb::Space::Vec2& position)
         { this->position = position; }
 
+        /**
+         * @brief Gets the OpenGL ID of the element's vertex array object.
+         * 
+         * @return The OpenGL ID of the VAO.
+         */
+        GLuint getVertexArrayID() const
+        {
+          const crb::Graphics::MeshBuffers* buffers = crb::Graphics::getMesh(this->mesh);
+          return buffers != NULL ? buffers->vertexArray : 0u;
+        }
+
         /**
          * @brief Renders the GUI element.
          * 
@@ -35,9 +79,21 @@ namespace crb
         void render(const crb::Graphics::Shader& shader) const;
 
       private:
-        crb::Graphics::VAO* VAO {NULL};
-        crb::Graphics::VBO* VBO {NULL};
-        crb::Graphics::EBO* EBO {NULL};
+        // Elements lie in the GUI plane, so the depth is left to its default of 0
+        using VertexFormat = crb::Graphics::VertexFormat<
+          crb::Graphics::Attribute<0, 2, GL_FLOAT>,
+          crb::Graphics::Attribute<1, 2, GL_UNSIGNED_SHORT, GL_TRUE>
+        >;
+        struct Vertex
+        {
+          GLfloat  x;
+          GLfloat  y;
+          GLushort u;
+          GLushort v;
+        };
+        static_assert(sizeof(Vertex) == VertexFormat::STRIDE, "GUI vertices must match their format");
+
+        crb::Graphics::MeshHandle mesh;
 
         crb::Space::Vec2 position {0.f};
     };
@@ -0,0 +1,138 @@
+#ifndef CRB_GPU_TIMER_HPP
+#define CRB_GPU_TIMER_HPP
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Profiler.hpp"
+
+namespace crb
+{
+  namespace Graphics
+  {
+    /**
+     * @class GpuTimer
+     * @brief Measures the GPU time of named scopes with timestamp queries.
+     *
+     * Every frame records its queries into one of FRAME_COUNT query sets, and the results
+     * are only read once the GPU reports them as available, so measuring never stalls the
+     * CPU. Results therefore lag a few frames behind. Scopes may be nested. With the
+     * profiler enabled, the scopes are also written to the "GPU" track of the trace.
+     *
+     * Renderers which defer the draws until a flush (e.g. Mesa's llvmpipe) record every
+     * timestamp of a batch at once. On those, the timer can flush the commands around every
+     * timestamp, and scopes should then cover whole passes rather than single draws.
+     */
+    class GpuTimer
+    {
+      public:
+        /**
+         * @brief The number of frames that can be in flight before their results are dropped.
+         */
+        static constexpr std::size_t FRAME_COUNT {4u};
+
+        /**
+         * @brief Constructs a GpuTimer object. Queries are only created once they are needed.
+         *
+         * @param flushQueries Whether to flush the commands before and after every timestamp, see isRendererDeferred().
+         */
+        explicit GpuTimer(const bool flushQueries = false)
+        : flushQueries(flushQueries)
+        {}
+        /**
+         * @brief Destructor to release associated OpenGL resources.
+         */
+        ~GpuTimer();
+        GpuTimer(const crb::Graphics::GpuTimer& other) = delete;
+        crb::Graphics::GpuTimer& operator=(const crb::Graphics::GpuTimer& other) = delete;
+
+        /**
+         * @brief Gets the GPU time of a scope.
+         *
+         * @param name The name of the scope.
+         * @return The time of the scope in the latest measured frame, in milliseconds, or 0 if it was not measured.
+         */
+        double getMilliseconds(const std::string& name) const;
+        /**
+         * @brief Checks if the renderer of the current context only runs draws once they are flushed.
+         *
+         * Timestamps recorded between such draws all read the same time, unless the timer
+         * flushes around them.
+         *
+         * @return True for renderers known to defer draws (llvmpipe), false otherwise.
+         */
+        static bool isRendererDeferred();
+
+        /**
+         * @brief Gets the number of frames whose results were not available in time.
+         *
+         * @return The number of dropped frames.
+         */
+        std::size_t getDroppedFrameCount() const
+        { return this->droppedFrames; }
+
+        /**
+         * @brief Starts a frame, reading the results of the previous frames that the GPU has finished.
+         */
+        void beginFrame();
+        /**
+         * @brief Starts measuring a scope.
+         *
+         * @param name The name of the scope. Must outlive the timer, usually a string literal.
+         */
+        void begin(const char* name);
+        /**
+         * @brief Stops measuring the innermost scope.
+         */
+        void end();
+
+      private:
+        struct Scope
+        {
+          const char* name;
+          std::size_t startQuery;
+          std::size_t endQuery;
+        };
+
+        struct Frame
+        {
+          std::vector<GLuint> queries;
+          std::vector<Scope>  scopes;
+          std::size_t         usedQueries {0u};
+          std::int64_t        clockOffset {0};
+          bool                pending     {false};
+        };
+
+        /**
+         * @brief Internal method for taking the next unused query of the current frame.
+         *
+         * @return The index of the query in the current frame.
+         */
+        std::size_t _acquire();
+        /**
+         * @brief Internal method for reading the results of a frame if the GPU has finished it.
+         *
+         * @param frame The frame.
+         * @return True if the results were read, false if they are not available yet.
+         */
+        bool _resolve(crb::Graphics::GpuTimer::Frame& frame);
+
+        crb::Graphics::GpuTimer::Frame frames[FRAME_COUNT];
+        std::vector<std::size_t>       openScopes;
+
+        std::unordered_map<std::string, double> milliseconds;
+
+        std::size_t current       {0u};
+        std::size_t droppedFrames {0u};
+
+        bool flushQueries {false};
+    };
+  }
+}
+
+#endif // CRB_GPU_TIMER_HPP
@@ -2,12 +2,17 @@
 #define CRB_GRAPHICS_HPP
 
 #include <GL/glew.h>
+#include <cstddef>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "Constants.hpp"
 #include "File.hpp"
 #include "Image.hpp"
 #include "Space.hpp"
+#include "State.hpp"
+#include "VertexLayout.hpp"
 
 namespace crb
 {
@@ -20,17 +25,17 @@ namespace crb
      * @brief Sets the OpenGL rendering mode to point mode.
      */
     inline void usePointMode()
-    { glPolygonMode(GL_FRONT_AND_BACK, GL_POINT); }
+    { crb::Graphics::State::setPolygonMode(GL_POINT); }
     /**
      * @brief Sets the OpenGL rendering mode to line mode.
      */
     inline void useLineMode()
-    { glPolygonMode(GL_FRONT_AND_BACK, GL_LINE); }
+    { crb::Graphics::State::setPolygonMode(GL_LINE); }
     /**
      * @brief Sets the OpenGL rendering mode to fill mode.
      */
     inline void useFillMode()
-    { glPolygonMode(GL_FRONT_AND_BACK, GL_FILL); }
+    { crb::Graphics::State::setPolygonMode(GL_FILL); }
 
     /**
      * @brief Sets the size of points when rendered in point mode.
@@ -52,13 +57,91 @@ namespace crb
     class Shader
     {
       public:
+        /**
+         * @brief A handle to an active uniform, resolved once and typed by the value it accepts.
+         *
+         * Handles are obtained from getUniform() and stay valid as long as the shader program.
+         * Setting an invalid handle does nothing, like setting location -1 in OpenGL.
+         */
+        template <typename T>
+        class Uniform
+        {
+          public:
+            /**
+             * @brief Constructs an invalid Uniform handle.
+             */
+            Uniform()
+            {}
+
+            /**
+             * @brief Checks whether the handle refers to an active uniform.
+             *
+             * @return True if the uniform is active in the shader program, false otherwise.
+             */
+            bool isValid() const
+            { return this->slot != NO_SLOT; }
+
+          private:
+            friend class Shader;
+
+            static constexpr std::size_t NO_SLOT {(std::size_t)-1};
+
+            explicit Uniform(const std::size_t slot)
+            : slot(slot)
+            {}
+
+            std::size_t slot {NO_SLOT};
+        };
+
+        /**
+         * @brief When the shader program is compiled.
+         */
+        enum Compilation
+        {
+          Blocking,
+          Deferred,
+        };
+
         /**
          * @brief Constructs a Shader object by loading and compiling the specified vertex and fragment shader files.
          *
+         * If a program binary cache directory is set, a cached binary of the same sources built
+         * by the same driver is loaded instead, and freshly linked programs are added to the cache.
+         *
          * @param vertexPath The file path to the vertex shader source code.
          * @param fragmentPath The file path to the fragment shader source code.
          */
-        Shader(const std::string& vertexPath, const std::string& fragmentPath);
+        Shader(const std::string& vertexPath, const std::string& fragmentPath)
+        : Shader(vertexPath, fragmentPath, crb::Graphics::Shader::Blocking)
+        {}
+        /**
+         * @brief Constructs a Shader object, optionally without waiting for the compilation.
+         *
+         * With Deferred compilation, the stages are compiled and linked without checking their status,
+         * so the driver can compile several programs in parallel (GL_KHR_parallel_shader_compile)
+         * while the caller keeps loading other resources. The shader must not be used before poll()
+         * returned true or finish() was called.
+         *
+         * @param vertexPath The file path to the vertex shader source code.
+         * @param fragmentPath The file path to the fragment shader source code.
+         * @param compilation Whether to wait for the compilation.
+         */
+        Shader(const std::string& vertexPath, const std::string& fragmentPath, const crb::Graphics::Shader::Compilation compilation);
+
+        /**
+         * @brief Gets the directory of the program binary cache.
+         *
+         * @return The directory of the cache, empty if the cache is disabled.
+         */
+        static const std::string& getBinaryCacheDirectory()
+        { return binaryCacheDirectory; }
+        /**
+         * @brief Sets the directory of the program binary cache, used by shaders constructed afterwards.
+         *
+         * @param directory The directory of the cache, or an empty string to disable the cache.
+         */
+        static void setBinaryCacheDirectory(const std::string& directory)
+        { binaryCacheDirectory = directory; }
 
         /**
          * @brief Gets the OpenGL ID of the shader program.
@@ -67,43 +150,225 @@ namespace crb
          */
         GLuint getID() const
         { return this->ID; }
+        /**
+         * @brief Checks whether the shader program is linked and ready to use.
+         *
+         * @return True if the program is ready, false if a deferred compilation is still running or failed.
+         */
+        bool isReady() const
+        { return this->ready; }
+        /**
+         * @brief Checks whether the compilation or linking of the shader program failed.
+         *
+         * @return True if the program failed to link and must not be used, false otherwise.
+         */
+        bool hasFailed() const
+        { return this->failed; }
+        /**
+         * @brief Checks whether the program was loaded from the program binary cache.
+         *
+         * @return True if the program was loaded from the cache, false if it was compiled.
+         */
+        bool isFromBinaryCache() const
+        { return this->fromBinaryCache; }
+        /**
+         * @brief Gets the number of active uniforms found when the program was linked.
+         *
+         * @return The number of active uniforms.
+         */
+        std::size_t getUniformCount() const
+        { return this->uniforms.size(); }
+        /**
+         * @brief Gets the number of uniform uploads skipped because the value did not change.
+         *
+         * @return The number of skipped uploads since the program was linked.
+         */
+        std::size_t getSkippedUploadCount() const
+        { return this->skippedUploads; }
+        /**
+         * @brief Gets the location of an active uniform without querying OpenGL.
+         *
+         * @param uniform The name of the uniform variable.
+         * @return The location of the uniform, or -1 if it is not active.
+         */
+        GLint getUniformLocation(const std::string& uniform) const;
+        /**
+         * @brief Gets a typed handle to an active uniform.
+         *
+         * @tparam T The type of the uniform value, int or crb::Space::Mat4.
+         * @param uniform The name of the uniform variable.
+         * @return The handle, which is invalid if the uniform is not active.
+         */
+        template <typename T>
+        crb::Graphics::Shader::Uniform<T> getUniform(const std::string& uniform) const
+        {
+          auto slot = this->uniformSlots.find(uniform);
+          return slot != this->uniformSlots.end()
+            ? crb::Graphics::Shader::Uniform<T>(slot->second)
+            : crb::Graphics::Shader::Uniform<T>();
+        }
+
+        /**
+         * @brief Assigns a uniform block of the shader program to a uniform buffer binding point.
+         *
+         * Does nothing if the program has no active block with that name.
+         *
+         * @param block The name of the uniform block.
+         * @param binding The binding point.
+         */
+        void BindUniformBlock(const std::string& block, GLuint binding) const;
+
+        /**
+         * @brief Checks whether a deferred compilation has completed, and finishes the program if so.
+         *
+         * Never blocks when the driver supports parallel shader compilation. Otherwise the first
+         * call waits for the compilation.
+         *
+         * @return True if the program is ready to use, false if it is still compiling or failed to link.
+         */
+        bool poll();
+        /**
+         * @brief Waits for a deferred compilation and finishes the program.
+         *
+         * The program is left not ready if it failed to link.
+         *
+         * @return True if the program was linked, false otherwise.
+         */
+        bool finish();
 
         /**
          * @brief Activates the shader program for use.
          */
         void Use() const
-        { glUseProgram(this->ID); }
+        { crb::Graphics::State::useProgram(this->ID); }
         /**
          * @brief Deletes the shader program, releasing associated OpenGL resources.
          */
         void Delete()
-        { glDeleteProgram(this->ID); }
+        {
+          crb::Graphics::State::forgetProgram(this->ID);
+          glDeleteProgram(this->ID);
+          glDeleteShader(this->vertexStage);
+          glDeleteShader(this->fragmentStage);
+          this->vertexStage = 0;
+          this->fragmentStage = 0;
+          this->uniforms.clear();
+          this->uniformSlots.clear();
+        }
 
         /**
          * @brief Sets the value of a uniform integer variable in the shader program.
          *
+         * The shader program must be in use. Nothing is uploaded if the value did not change.
+         *
          * @param value The integer value to set.
          * @param uniform The name of the uniform variable.
          */
         void SetInt(int value, const std::string& uniform) const
-        {
-          GLuint intLoc = glGetUniformLocation(this->ID, uniform.c_str());
-          glUniform1i(intLoc, value);
-        }
+        { this->SetInt(value, this->getUniform<int>(uniform)); }
+        /**
+         * @brief Sets the value of a uniform integer variable in the shader program.
+         *
+         * The shader program must be in use. Nothing is uploaded if the value did not change.
+         *
+         * @param value The integer value to set.
+         * @param uniform The handle of the uniform variable.
+         */
+        void SetInt(int value, const crb::Graphics::Shader::Uniform<int>& uniform) const;
         /**
          * @brief Sets the value of a uniform matrix variable in the shader program.
          *
+         * The shader program must be in use. Nothing is uploaded if the value did not change.
+         *
          * @param mat The matrix value to set.
          * @param uniform The name of the uniform matrix variable.
          */
         void SetMatrix4(const crb::Space::Mat4& mat, const std::string& uniform) const
-        {
-          GLuint matLoc = glGetUniformLocation(this->ID, uniform.c_str());
-          glUniformMatrix4fv(matLoc, 1, GL_FALSE, crb::Space::valuePointer(mat));
-        }
+        { this->SetMatrix4(mat, this->getUniform<crb::Space::Mat4>(uniform)); }
+        /**
+         * @brief Sets the value of a uniform matrix variable in the shader program.
+         *
+         * The shader program must be in use. Nothing is uploaded if the value did not change.
+         *
+         * @param mat The matrix value to set.
+         * @param uniform The handle of the uniform matrix variable.
+         */
+        void SetMatrix4(const crb::Space::Mat4& mat, const crb::Graphics::Shader::Uniform<crb::Space::Mat4>& uniform) const;
 
       private:
-        GLuint ID;
+        /**
+         * @brief An active uniform and the last value uploaded to it.
+         */
+        struct UniformSlot
+        {
+          GLint   location {-1};
+          GLenum  type     {GL_NONE};
+          bool    cached   {false};
+          GLfloat value[16];
+        };
+
+        /**
+         * @brief Internal method for starting the compilation and linking of the shader program.
+         *
+         * @param vertexSource The vertex shader source code.
+         * @param fragmentSource The fragment shader source code.
+         * @param retrievable Whether the linked binary will be retrieved for the cache.
+         */
+        void _submit(const std::string& vertexSource, const std::string& fragmentSource, const bool retrievable);
+        /**
+         * @brief Internal method for checking the results of the compilation and preparing the program for use.
+         *
+         * Blocks until the compilation has completed.
+         *
+         * @return True if the program was linked, false otherwise.
+         */
+        bool _link();
+        /**
+         * @brief Internal method for reflecting the uniforms of the linked program and binding its uniform blocks.
+         */
+        void _prepare();
+        /**
+         * @brief Internal method for loading the shader program from a cached binary.
+         *
+         * @param path The path to the cached binary.
+         * @return True if the binary was accepted by the driver, false otherwise.
+         */
+        bool _loadBinary(const std::string& path);
+        /**
+         * @brief Internal method for writing the linked shader program to the cache.
+         *
+         * @param path The path to the cached binary.
+         */
+        void _saveBinary(const std::string& path) const;
+        /**
+         * @brief Internal method for building the uniform lookup table from the linked program.
+         */
+        void _reflect();
+        /**
+         * @brief Internal method for updating the cached value of a uniform.
+         *
+         * @param slot The index of the uniform.
+         * @param value The new value.
+         * @param size The size of the value in bytes.
+         * @return True if the value changed and must be uploaded, false otherwise.
+         */
+        bool _cache(const std::size_t slot, const void* value, const std::size_t size) const;
+
+        inline static std::string binaryCacheDirectory;
+
+        GLuint ID {0u};
+        bool   fromBinaryCache {false};
+        bool   ready {false};
+        bool   failed {false};
+
+        // Deferred compilation state, released once the program is ready
+        GLuint      vertexStage   {0u};
+        GLuint      fragmentStage {0u};
+        std::string cachePath;
+
+        mutable std::vector<crb::Graphics::Shader::UniformSlot> uniforms;
+        std::unordered_map<std::string, std::size_t>            uniformSlots;
+        mutable std::size_t                                     skippedUploads {0u};
     };
 
     /**
@@ -120,10 +385,20 @@ namespace crb
         /**
          * @brief Constructs a VBO object with the specified vertex data.
          *
-         * @param vertices An array of GLfloat containing vertex data.
-         * @param verticesSize The size of the vertex data array.
+         * @param vertices The vertex data, laid out as described by a VertexLayout.
+         * @param verticesSize The size of the vertex data in bytes.
          */
-        VBO(GLfloat vertices[], GLsizeiptr verticesSize);
+        VBO(const void* vertices, GLsizeiptr verticesSize)
+        : VBO(vertices, verticesSize, GL_STATIC_DRAW)
+        {}
+        /**
+         * @brief Constructs a VBO object with the specified vertex data and usage hint.
+         *
+         * @param vertices The vertex data, laid out as described by a VertexLayout. May be NULL to only allocate storage.
+         * @param verticesSize The size of the vertex data in bytes.
+         * @param usage The expected usage pattern (e.g., GL_DYNAMIC_DRAW).
+         */
+        VBO(const void* vertices, GLsizeiptr verticesSize, GLenum usage);
 
         /**
          * @brief Gets the OpenGL ID of the VBO.
@@ -137,17 +412,28 @@ namespace crb
          * @brief Binds the VBO.
          */
         void Bind() const
-        { glBindBuffer(GL_ARRAY_BUFFER, this->ID); }
+        { crb::Graphics::State::bindBuffer(GL_ARRAY_BUFFER, this->ID); }
         /**
          * @brief Unbinds the VBO.
          */
         void Unbind() const
-        { glBindBuffer(GL_ARRAY_BUFFER, 0); }
+        { crb::Graphics::State::bindBuffer(GL_ARRAY_BUFFER, 0); }
         /**
          * @brief Deletes the VBO, releasing associated OpenGL resources.
          */
         void Delete()
-        { glDeleteBuffers(1, &this->ID); }
+        {
+          crb::Graphics::State::forgetBuffer(this->ID);
+          glDeleteBuffers(1, &this->ID);
+        }
+        /**
+         * @brief Replaces the whole content of the VBO, orphaning the previous storage.
+         *
+         * @param vertices The vertex data, laid out as described by a VertexLayout.
+         * @param verticesSize The size of the vertex data in bytes.
+         * @param usage The expected usage pattern (e.g., GL_DYNAMIC_DRAW).
+         */
+        void SetData(const void* vertices, GLsizeiptr verticesSize, GLenum usage);
 
       private:
         GLuint ID;
@@ -170,7 +456,7 @@ namespace crb
          * @param indices An array of GLuint containing index data.
          * @param indicesSize The size of the index data array.
          */
-        EBO(GLuint indices[], GLsizeiptr indicesSize);
+        EBO(const GLuint indices[], GLsizeiptr indicesSize);
 
         /**
          * @brief Gets the OpenGL ID of the EBO.
@@ -184,22 +470,94 @@ namespace crb
          * @brief Binds the EBO.
          */
         void Bind() const
-        { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ID); }
+        { crb::Graphics::State::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ID); }
         /**
          * @brief Unbinds the EBO.
          */
         void Unbind() const
-        { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); }
+        { crb::Graphics::State::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); }
         /**
          * @brief Deletes the EBO, releasing associated OpenGL resources.
          */
         void Delete()
-        { glDeleteBuffers(1, &this->ID); }
+        {
+          crb::Graphics::State::forgetBuffer(this->ID);
+          glDeleteBuffers(1, &this->ID);
+        }
 
       private:
         GLuint ID;
     };
 
+    /**
+     * @class UBO
+     * @brief Encapsulates an OpenGL Uniform Buffer Object (UBO).
+     * 
+     * The UBO is attached to a fixed binding point, from which every shader
+     * program with a matching uniform block reads it.
+     */
+    class UBO
+    {
+      public:
+        /**
+         * @brief Constructs a UBO object and attaches it to a binding point.
+         *
+         * @param size The size of the buffer in bytes.
+         * @param binding The uniform buffer binding point.
+         */
+        UBO(GLsizeiptr size, GLuint binding);
+
+        /**
+         * @brief Gets the OpenGL ID of the UBO.
+         *
+         * @return The OpenGL ID of the UBO.
+         */
+        GLuint getID() const
+        { return this->ID; }
+        /**
+         * @brief Gets the binding point of the UBO.
+         *
+         * @return The uniform buffer binding point.
+         */
+        GLuint getBinding() const
+        { return this->binding; }
+
+        /**
+         * @brief Binds the UBO.
+         */
+        void Bind() const
+        { crb::Graphics::State::bindBuffer(GL_UNIFORM_BUFFER, this->ID); }
+        /**
+         * @brief Unbinds the UBO.
+         */
+        void Unbind() const
+        { crb::Graphics::State::bindBuffer(GL_UNIFORM_BUFFER, 0); }
+        /**
+         * @brief Attaches the UBO to its binding point.
+         */
+        void BindBase() const
+        { crb::Graphics::State::bindBufferBase(GL_UNIFORM_BUFFER, this->binding, this->ID); }
+        /**
+         * @brief Deletes the UBO, releasing associated OpenGL resources.
+         */
+        void Delete()
+        {
+          crb::Graphics::State::forgetBuffer(this->ID);
+          glDeleteBuffers(1, &this->ID);
+        }
+        /**
+         * @brief Replaces the whole content of the UBO, orphaning the previous storage.
+         *
+         * @param data The new content, laid out as std140.
+         */
+        void SetData(const void* data);
+
+      private:
+        GLuint     ID;
+        GLuint     binding {0u};
+        GLsizeiptr size    {0};
+    };
+
     /**
      * @class VAO
      * @brief Encapsulates an OpenGL Vertex Array Object (VAO).
@@ -232,17 +590,20 @@ namespace crb
          * @brief Binds the VAO.
          */
         void Bind() const
-        { glBindVertexArray(this->ID); }
+        { crb::Graphics::State::bindVertexArray(this->ID); }
         /**
          * @brief Unbinds the VAO.
          */
         void Unbind() const
-        { glBindVertexArray(0); }
+        { crb::Graphics::State::bindVertexArray(0); }
         /**
          * @brief Deletes the VAO, releasing associated OpenGL resources.
          */
         void Delete()
-        { glDeleteVertexArrays(1, &this->ID); }
+        {
+          crb::Graphics::State::forgetVertexArray(this->ID);
+          glDeleteVertexArrays(1, &this->ID);
+        }
         /**
          * @brief Links a vertex attribute to the VAO.
          *
@@ -254,6 +615,21 @@ namespace crb
          * @param offset The offset of the first component of the first generic vertex attribute.
          */
         void LinkAttribute(const crb::Graphics::VBO& VBO, GLuint layout, GLuint size, GLenum type, GLsizeiptr stride, const void* offset) const;
+        /**
+         * @brief Links every attribute of a vertex layout to the VAO.
+         *
+         * @param VBO The VBO containing the vertex data.
+         * @param layout The layout of the vertices in the VBO.
+         */
+        void LinkLayout(const crb::Graphics::VBO& VBO, const crb::Graphics::VertexLayout& layout) const;
+        /**
+         * @brief Sets how often a vertex attribute advances during instanced rendering.
+         *
+         * @param layout The attribute layout location.
+         * @param divisor The number of instances per attribute value, or 0 to advance per vertex.
+         */
+        void SetAttributeDivisor(GLuint layout, GLuint divisor) const
+        { glVertexAttribDivisor(layout, divisor); }
 
       private:
         GLuint ID;
@@ -285,24 +661,27 @@ namespace crb
          * @brief Binds the texture for rendering.
          */
         void Bind() const
-        { glBindTexture(this->type, this->ID); }
+        { crb::Graphics::State::bindTexture(this->type, this->ID); }
         /**
          * @brief Unbinds the texture.
          */
         void Unbind() const
-        { glBindTexture(this->type, 0); }
+        { crb::Graphics::State::bindTexture(this->type, 0); }
         /**
          * @brief Deletes the texture from OpenGL memory.
          */
         void Delete()
-        { glDeleteTextures(1, &this->ID); }
+        {
+          crb::Graphics::State::forgetTexture(this->ID);
+          glDeleteTextures(1, &this->ID);
+        }
         /**
          * @brief Applies the texture to a texture unit in the shader.
          * 
          * @param shader The shader program to which the texture will be applied.
          * @param unit The texture unit to which the texture will be bound.
          */
-        void ApplyUnit(const crb::Graphics::Shader& shader, GLuint unit)
+        void ApplyUnit(const crb::Graphics::Shader& shader, GLuint unit) const
         { shader.SetInt(unit, "tex0"); }
 
       private:
@@ -7,6 +7,10 @@
 #include <stdio.h>
 #include <iostream>
 #include <string>
+#include <vector>
+
+#include "File.hpp"
+#include "Profiler.hpp"
 
 namespace crb
 {
@@ -26,6 +30,18 @@ namespace crb
      * @return true if the image loading was successful, false otherwise.
      */
     bool loadFromPNG(const std::string& path, GLubyte** oData, unsigned int &oWidth, unsigned int &oHeight, bool &oHasAlpha);
+    /**
+     * @brief Saves 8-bit RGB or RGBA image data to a PNG file, creating its parent directories if needed.
+     * 
+     * @param path The file path to the PNG image.
+     * @param data The image data, rows without padding.
+     * @param width The width of the image.
+     * @param height The height of the image.
+     * @param hasAlpha Whether the data has an alpha channel.
+     * @param flipVertically Whether the first row of the data is the bottom of the image, as OpenGL reads it.
+     * @return true if the image saving was successful, false otherwise.
+     */
+    bool saveToPNG(const std::string& path, const GLubyte* data, const unsigned int width, const unsigned int height, const bool hasAlpha, const bool flipVertically = false);
   }
 }
 
@@ -0,0 +1,111 @@
+#ifndef CRB_MESH_BUILDER_HPP
+#define CRB_MESH_BUILDER_HPP
+
+#include <GL/glew.h>
+#include <cstddef>
+
+#include "Constants.hpp"
+#include "Solids.hpp"
+#include "Space.hpp"
+
+namespace crb
+{
+  namespace Solids
+  {
+    /**
+     * @class MeshBuilder
+     * @brief Appends vertices and indices to a mesh whose storage is reused across builds.
+     *
+     * begin() takes the storage of a previously recycled mesh, and finish() hands the
+     * result off, for instance to another thread for upload. Giving the mesh back with
+     * recycle() once it is uploaded lets the next build reuse its memory, so generating
+     * meshes of the same size stops allocating after the first few builds.
+     */
+    class MeshBuilder
+    {
+      public:
+        /**
+         * @brief The maximum number of recycled meshes kept for reuse.
+         */
+        static constexpr std::size_t POOL_CAPACITY {32u};
+
+        /**
+         * @brief Gives the storage of a mesh back for reuse by later builds. Can be called from any thread.
+         *
+         * @param mesh The mesh, which is left empty.
+         */
+        static void recycle(crb::Solids::Mesh&& mesh);
+
+        /**
+         * @brief Constructs a MeshBuilder object.
+         */
+        MeshBuilder()
+        {}
+        MeshBuilder(const crb::Solids::MeshBuilder& other) = delete;
+        crb::Solids::MeshBuilder& operator=(const crb::Solids::MeshBuilder& other) = delete;
+
+        /**
+         * @brief Gets the number of vertices added so far.
+         *
+         * @return The number of vertices, which is also the index of the next vertex.
+         */
+        GLuint getVertexCount() const
+        { return (GLuint)(this->mesh.vertices.size() / crb::Solids::VERTEX_FLOATS); }
+        /**
+         * @brief Gets the number of indices added so far.
+         *
+         * @return The number of indices.
+         */
+        std::size_t getIndexCount() const
+        { return this->mesh.indices.size(); }
+
+        /**
+         * @brief Starts a mesh, reusing recycled storage if there is any.
+         *
+         * If the storage held by the builder is too small, it is exchanged with a recycled mesh
+         * and returned to the pool instead of being freed.
+         *
+         * @param vertexCount The expected number of vertices, reserved up front.
+         * @param indexCount The expected number of indices, reserved up front.
+         */
+        void begin(const std::size_t vertexCount, const std::size_t indexCount);
+        /**
+         * @brief Appends a vertex.
+         *
+         * @param position The position of the vertex.
+         * @param u The horizontal texture coordinate.
+         * @param v The vertical texture coordinate.
+         * @return The index of the vertex.
+         */
+        GLuint addVertex(const crb::Space::Vec3& position, const float u, const float v)
+        {
+          const GLuint index = this->getVertexCount();
+          this->mesh.vertices.insert(this->mesh.vertices.end(), {position.x, position.y, position.z, u, v});
+          return index;
+        }
+        /**
+         * @brief Appends an index.
+         *
+         * @param index The index of a vertex, or crb::PRIMITIVE_RESTART_INDEX to restart the primitive.
+         */
+        void addIndex(const GLuint index)
+        { this->mesh.indices.push_back(index); }
+        /**
+         * @brief Appends the index that restarts strip and fan primitives.
+         */
+        void restartPrimitive()
+        { this->mesh.indices.push_back(crb::PRIMITIVE_RESTART_INDEX); }
+        /**
+         * @brief Ends the mesh and hands it off, leaving the builder empty.
+         *
+         * @return The built mesh.
+         */
+        crb::Solids::Mesh finish();
+
+      private:
+        crb::Solids::Mesh mesh;
+    };
+  }
+}
+
+#endif // CRB_MESH_BUILDER_HPP
@@ -0,0 +1,164 @@
+#ifndef CRB_MESH_CACHE_HPP
+#define CRB_MESH_CACHE_HPP
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <tuple>
+
+#include "DeletionQueue.hpp"
+#include "ResourcePool.hpp"
+#include "Solids.hpp"
+#include "Space.hpp"
+#include "VertexLayout.hpp"
+
+namespace crb
+{
+  namespace Solids
+  {
+    /**
+     * @class MeshCache
+     * @brief Shares the uploaded mesh of every solid generated from the same parameters.
+     *
+     * The first solid created from a set of parameters generates and uploads the mesh,
+     * the following ones only add a reference to it and differ in position alone. The
+     * cache itself holds no reference, so a mesh is released with the last solid using
+     * it and regenerated if it is needed again.
+     *
+     * Meshes belong to the OpenGL context, so the cache must only be used on the render thread.
+     * To keep generation off that thread, check isCached() first, generate the mesh elsewhere
+     * on a miss, then upload() it and create() the solids.
+     */
+    class MeshCache
+    {
+      public:
+        /**
+         * @brief The kinds of procedural meshes.
+         */
+        enum Primitive
+        {
+          Plane,
+        };
+
+        /**
+         * @brief The parameters a procedural mesh is generated from.
+         */
+        struct Key
+        {
+          crb::Solids::MeshCache::Primitive  primitive    {crb::Solids::MeshCache::Plane};
+          float                              length       {0.f};
+          float                              width        {0.f};
+          unsigned int                       segmentCount {0u};
+          const crb::Graphics::VertexLayout* layout       {NULL};
+
+          bool operator<(const crb::Solids::MeshCache::Key& other) const
+          {
+            return std::tie(this->primitive, this->length, this->width, this->segmentCount, this->layout)
+              < std::tie(other.primitive, other.length, other.width, other.segmentCount, other.layout);
+          }
+        };
+
+        /**
+         * @brief Constructs a MeshCache object.
+         *
+         * @param deletionQueue The queue reusing and releasing the buffers of the meshes, or NULL to delete them directly. Must outlive the solids.
+         */
+        MeshCache(crb::Graphics::DeletionQueue* deletionQueue = NULL)
+        : deletionQueue(deletionQueue)
+        {}
+        MeshCache(const crb::Solids::MeshCache& other) = delete;
+        crb::Solids::MeshCache& operator=(const crb::Solids::MeshCache& other) = delete;
+
+        /**
+         * @brief Gets the number of solids created from a mesh that was already uploaded.
+         *
+         * @return The number of cache hits.
+         */
+        std::size_t getHitCount() const
+        { return this->hitCount; }
+        /**
+         * @brief Gets the number of solids whose mesh had to be generated and uploaded.
+         *
+         * @return The number of cache misses.
+         */
+        std::size_t getMissCount() const
+        { return this->missCount; }
+
+        /**
+         * @brief Gets the parameters of a plane mesh.
+         *
+         * @param length The length of the plane.
+         * @param width The width of the plane.
+         * @param segmentCount The number of segments in the plane's geometry.
+         * @return The key of the plane mesh.
+         */
+        static crb::Solids::MeshCache::Key getPlaneKey(const float length, const float width, const unsigned int segmentCount)
+        { return {crb::Solids::MeshCache::Plane, length, width, segmentCount, &crb::Solids::VertexFormat::LAYOUT}; }
+
+        /**
+         * @brief Checks whether the mesh of a set of parameters is uploaded and can be shared.
+         *
+         * @param key The parameters of the mesh.
+         * @return True if create() can share the mesh, false if it has to be uploaded first.
+         */
+        bool isCached(const crb::Solids::MeshCache::Key& key) const;
+        /**
+         * @brief Uploads the mesh generated for a set of parameters, unless it is already cached.
+         *
+         * @param key The parameters the mesh was generated from.
+         * @param mesh The generated mesh, which can be recycled afterwards.
+         */
+        void upload(const crb::Solids::MeshCache::Key& key, const crb::Solids::Mesh& mesh);
+        /**
+         * @brief Creates a solid sharing a cached mesh.
+         *
+         * @param position The position of the solid.
+         * @param key The parameters of the mesh. Must be cached.
+         * @return The created solid, or nothing if the mesh was not cached.
+         */
+        std::optional<crb::Solids::Solid> create(const crb::Space::Vec3& position, const crb::Solids::MeshCache::Key& key);
+        /**
+         * @brief Creates a plane object, sharing the mesh of the planes with the same dimensions.
+         *
+         * A miss generates the mesh on the calling thread.
+         *
+         * @param position The position of the plane.
+         * @param length The length of the plane.
+         * @param width The width of the plane.
+         * @param segmentCount The number of segments in the plane's geometry.
+         * @return The created plane object, or nothing if its mesh could not be uploaded.
+         */
+        std::optional<crb::Solids::Solid> createPlane(const crb::Space::Vec3& position, const float length, const float width, const unsigned int segmentCount);
+
+      private:
+        /**
+         * @brief An uploaded mesh, alive as long as a solid holds a reference to it.
+         */
+        struct Entry
+        {
+          crb::Graphics::MeshHandle mesh;
+          crb::Space::AABB          bounds;
+          GLuint                    vertexCount {0u};
+        };
+
+        crb::Graphics::DeletionQueue* deletionQueue {NULL};
+
+        std::map<crb::Solids::MeshCache::Key, crb::Solids::MeshCache::Entry> entries;
+
+        std::size_t hitCount  {0u};
+        std::size_t missCount {0u};
+
+        /**
+         * @brief Internal method for creating a solid sharing a cached mesh, without counting a hit.
+         *
+         * @param position The position of the solid.
+         * @param key The parameters of the mesh.
+         * @return The created solid, or nothing if the mesh is not cached.
+         */
+        std::optional<crb::Solids::Solid> _share(const crb::Space::Vec3& position, const crb::Solids::MeshCache::Key& key);
+    };
+  }
+}
+
+#endif // CRB_MESH_CACHE_HPP
@@ -0,0 +1,117 @@
+#ifndef CRB_PROFILER_HPP
+#define CRB_PROFILER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Records a zone named after the given string literal, from this line to the end of the scope.
+ *
+ * Compiles to nothing unless CRB_ENABLE_PROFILER is defined.
+ */
+#if defined(CRB_ENABLE_PROFILER)
+  #define CRB_PROFILE_CONCAT_INNER(a, b) a##b
+  #define CRB_PROFILE_CONCAT(a, b) CRB_PROFILE_CONCAT_INNER(a, b)
+  #define CRB_PROFILE_SCOPE(name) const crb::Profiler::Zone CRB_PROFILE_CONCAT(crbProfileZone, __LINE__) {name}
+  #define CRB_PROFILE_FUNCTION() CRB_PROFILE_SCOPE(__func__)
+  #define CRB_PROFILE_THREAD(name) crb::Profiler::setThreadName(name)
+#else
+  #define CRB_PROFILE_SCOPE(name) ((void)0)
+  #define CRB_PROFILE_FUNCTION() ((void)0)
+  #define CRB_PROFILE_THREAD(name) ((void)0)
+#endif
+
+namespace crb
+{
+  /**
+   * @brief Contains the scoped-zone CPU profiler of the Ceremonial Robes Engine.
+   *
+   * Every thread records its zones into its own ring buffer, so the newest zones are kept
+   * when a thread records more than EVENT_CAPACITY of them. Zones are usually recorded
+   * through the CRB_PROFILE_SCOPE and CRB_PROFILE_FUNCTION macros.
+   */
+  namespace Profiler
+  {
+    /**
+     * @brief The number of zones kept per thread.
+     */
+    constexpr std::size_t EVENT_CAPACITY {65536u};
+
+    /**
+     * @brief Gets the current time of the profiler clock.
+     *
+     * @return The number of nanoseconds since the profiler clock started.
+     */
+    std::uint64_t now();
+    /**
+     * @brief Records a finished zone in the ring buffer of the calling thread.
+     *
+     * @param name The name of the zone. Must outlive the profiler, usually a string literal.
+     * @param start The start time of the zone, in nanoseconds.
+     * @param end The end time of the zone, in nanoseconds.
+     */
+    void record(const char* name, const std::uint64_t start, const std::uint64_t end);
+    /**
+     * @brief Records a finished zone on a named track instead of the calling thread.
+     *
+     * Tracks show work that does not run on a CPU thread, such as GPU passes.
+     *
+     * @param track The name of the track, created on first use.
+     * @param name The name of the zone. Must outlive the profiler, usually a string literal.
+     * @param start The start time of the zone, in nanoseconds.
+     * @param end The end time of the zone, in nanoseconds.
+     */
+    void recordTrack(const std::string& track, const char* name, const std::uint64_t start, const std::uint64_t end);
+    /**
+     * @brief Names the calling thread in exported traces.
+     *
+     * @param name The name of the thread.
+     */
+    void setThreadName(const std::string& name);
+
+    /**
+     * @brief Writes the recorded zones of every thread as Chrome trace JSON.
+     *
+     * The file can be opened in chrome://tracing or Perfetto.
+     *
+     * @param path The path to the trace file.
+     * @return True if the file was written, false otherwise.
+     */
+    bool writeTrace(const std::string& path);
+    /**
+     * @brief Discards the recorded zones of every thread.
+     */
+    void clear();
+
+    /**
+     * @class Zone
+     * @brief Records the time between its construction and destruction.
+     */
+    class Zone
+    {
+      public:
+        /**
+         * @brief Constructs a Zone object and starts timing.
+         *
+         * @param name The name of the zone. Must outlive the profiler, usually a string literal.
+         */
+        explicit Zone(const char* name)
+        : name(name), start(crb::Profiler::now())
+        {}
+        /**
+         * @brief Destroys the Zone object and records it.
+         */
+        ~Zone()
+        { crb::Profiler::record(this->name, this->start, crb::Profiler::now()); }
+        Zone(const crb::Profiler::Zone& other) = delete;
+        crb::Profiler::Zone& operator=(const crb::Profiler::Zone& other) = delete;
+
+      private:
+        const char*   name;
+        std::uint64_t start;
+    };
+  }
+}
+
+#endif // CRB_PROFILER_HPP
@@ -0,0 +1,145 @@
+#ifndef CRB_RENDER_QUEUE_HPP
+#define CRB_RENDER_QUEUE_HPP
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Graphics.hpp"
+#include "GpuTimer.hpp"
+#include "Space.hpp"
+#include "Solids.hpp"
+#include "GUI.hpp"
+
+namespace crb
+{
+  /**
+   * @class RenderQueue
+   * @brief Collects the draw calls of a frame and submits them sorted by a 64-bit key.
+   *
+   * Opaque items are grouped by shader, texture and vertex array, then drawn front to back
+   * so that early depth testing rejects hidden fragments. Transparent items are drawn back
+   * to front with depth writes disabled. Overlay items (the GUI) are drawn last, without
+   * depth testing.
+   */
+  class RenderQueue
+  {
+    public:
+      /**
+       * @brief The passes of a frame, submitted in this order.
+       */
+      enum Pass
+      {
+        Opaque,
+        Transparent,
+        Overlay,
+      };
+
+      /**
+       * @brief Draws the object of an item with the item's shader already in use.
+       */
+      using DrawFunction = void (*)(const void* object, const crb::Graphics::Shader& shader, GLenum mode);
+
+      /**
+       * @brief A single draw call.
+       */
+      struct Item
+      {
+        const void*                    object      {NULL};
+        DrawFunction                   draw        {NULL};
+        const crb::Graphics::Shader*   shader      {NULL};
+        const crb::Graphics::Texture*  texture     {NULL};
+        GLuint                         vertexArray {0u};
+        GLenum                         mode        {GL_TRIANGLES};
+        crb::RenderQueue::Pass         pass        {crb::RenderQueue::Opaque};
+        float                          depth       {0.f};
+      };
+
+      /**
+       * @brief Default constructor.
+       */
+      RenderQueue()
+      {}
+
+      /**
+       * @brief Gets the number of queued items.
+       *
+       * @return The number of items submitted since the last flush.
+       */
+      std::size_t getItemCount() const
+      { return this->items.size(); }
+
+      /**
+       * @brief Starts a frame, discarding the items that were not flushed.
+       *
+       * @param viewPosition The position of the camera, used to compute the depth of items.
+       * @param farPlane The distance to the far clipping plane, used to quantize depths.
+       */
+      void begin(const crb::Space::Vec3& viewPosition, const float farPlane);
+      /**
+       * @brief Queues a draw call.
+       *
+       * @param item The draw call.
+       */
+      void submit(const crb::RenderQueue::Item& item)
+      { this->items.push_back(item); }
+      /**
+       * @brief Queues a solid, with its depth taken from the center of its bounding box.
+       *
+       * @param solid The solid to draw. Must stay alive until the queue is flushed.
+       * @param shader The shader program to draw it with.
+       * @param texture The texture bound to unit 0, or NULL.
+       * @param mode The primitive type to draw.
+       * @param pass The pass to draw it in.
+       */
+      void submit(const crb::Solids::Solid& solid, const crb::Graphics::Shader& shader, const crb::Graphics::Texture* texture, GLenum mode, const crb::RenderQueue::Pass pass = crb::RenderQueue::Opaque);
+      /**
+       * @brief Queues a GUI element in the overlay pass.
+       *
+       * @param element The element to draw. Must stay alive until the queue is flushed.
+       * @param shader The shader program to draw it with.
+       * @param texture The texture bound to unit 0, or NULL.
+       */
+      void submit(const crb::GUI::Element& element, const crb::Graphics::Shader& shader, const crb::Graphics::Texture* texture);
+
+      /**
+       * @brief Sorts the queued items, draws them and empties the queue.
+       *
+       * The depth mask and depth test are changed per pass through the shadow state, and
+       * restored to their previous values afterwards.
+       *
+       * @param timer The timer measuring the GPU time of every pass, or NULL.
+       * @return The number of items drawn.
+       */
+      std::size_t flush(crb::Graphics::GpuTimer* timer = NULL);
+
+    private:
+      struct Entry
+      {
+        std::uint64_t key;
+        std::uint32_t index;
+      };
+
+      /**
+       * @brief Internal method for computing the sort key of an item.
+       *
+       * @param item The item.
+       * @return The key, ordering items by pass first.
+       */
+      std::uint64_t _makeKey(const crb::RenderQueue::Item& item) const;
+      /**
+       * @brief Internal method for sorting the entries by key with a stable LSD radix sort.
+       */
+      void _sort();
+
+      std::vector<crb::RenderQueue::Item> items;
+      std::vector<Entry>                  entries;
+      std::vector<Entry>                  scratch;
+
+      crb::Space::Vec3 viewPosition {0.f};
+      float            farPlane     {1.f};
+  };
+}
+
+#endif // CRB_RENDER_QUEUE_HPP
@@ -0,0 +1,305 @@
+#ifndef CRB_RESOURCE_POOL_HPP
+#define CRB_RESOURCE_POOL_HPP
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "DeletionQueue.hpp"
+#include "VertexLayout.hpp"
+
+namespace crb
+{
+  namespace Graphics
+  {
+    /**
+     * @class Handle
+     * @brief Refers to a resource of a ResourcePool by slot and generation.
+     *
+     * Every insertion stamps its slot with a new generation, drawn from a counter shared by
+     * every pool of the same type, so a handle that outlived its resource, or that comes from
+     * another pool, is detected instead of reaching whatever occupies the slot.
+     *
+     * @tparam T The type of the resource.
+     */
+    template <typename T>
+    class Handle
+    {
+      public:
+        /**
+         * @brief Constructs a null Handle object.
+         */
+        constexpr Handle()
+        {}
+
+        /**
+         * @brief Checks whether the handle is null, rather than obtained from a pool.
+         *
+         * @return True if the handle is null, false otherwise. A handle that is not null may still be stale.
+         */
+        constexpr bool isNull() const
+        { return this->generation == 0u; }
+
+        constexpr bool operator==(const crb::Graphics::Handle<T>& other) const
+        { return this->index == other.index && this->generation == other.generation; }
+        constexpr bool operator!=(const crb::Graphics::Handle<T>& other) const
+        { return !(*this == other); }
+
+      private:
+        template <typename U>
+        friend class ResourcePool;
+
+        constexpr Handle(const std::uint32_t index, const std::uint32_t generation)
+        : index(index), generation(generation)
+        {}
+
+        std::uint32_t index      {0u};
+        std::uint32_t generation {0u};
+    };
+
+    /**
+     * @class ResourcePool
+     * @brief Stores resources in a dense array of slots and hands out generational handles to them.
+     *
+     * Freed slots are reused by later insertions. Resources are reference counted, so a
+     * resource shared by several owners is removed when the last of them releases it.
+     * The pool only stores values, releasing the OpenGL objects they name is up to the caller.
+     * Generations are unique across the pools of a type, so handles of one pool never
+     * resolve in another.
+     *
+     * @tparam T The type of the resources.
+     */
+    template <typename T>
+    class ResourcePool
+    {
+      public:
+        /**
+         * @brief Constructs an empty ResourcePool object.
+         */
+        ResourcePool()
+        {}
+        ResourcePool(const crb::Graphics::ResourcePool<T>& other) = delete;
+        crb::Graphics::ResourcePool<T>& operator=(const crb::Graphics::ResourcePool<T>& other) = delete;
+
+        /**
+         * @brief Gets the number of live resources.
+         *
+         * @return The number of resources that were inserted and not removed.
+         */
+        std::size_t getSize() const
+        { return this->values.size() - this->freeSlots.size(); }
+
+        /**
+         * @brief Stores a resource in a free slot, with a single reference.
+         *
+         * @param value The resource.
+         * @return The handle of the resource.
+         */
+        crb::Graphics::Handle<T> insert(const T& value)
+        {
+          std::uint32_t index;
+          if (!this->freeSlots.empty())
+          {
+            index = this->freeSlots.back();
+            this->freeSlots.pop_back();
+            this->values[index] = value;
+            this->references[index] = 1u;
+          }
+          else
+          {
+            index = (std::uint32_t)this->values.size();
+            this->values.push_back(value);
+            this->generations.push_back(0u);
+            this->references.push_back(1u);
+          }
+
+          // Skipping 0, which marks null handles and free slots
+          this->generations[index] = nextGeneration;
+          nextGeneration = nextGeneration + 1u == 0u ? 1u : nextGeneration + 1u;
+          return {index, this->generations[index]};
+        }
+        /**
+         * @brief Gets a resource.
+         *
+         * @param handle The handle of the resource.
+         * @return A pointer to the resource, or NULL if the handle is null or stale.
+         */
+        T* get(const crb::Graphics::Handle<T> handle)
+        { return this->_isLive(handle) ? &this->values[handle.index] : NULL; }
+        /**
+         * @brief Gets a resource (const version).
+         *
+         * @param handle The handle of the resource.
+         * @return A pointer to the resource, or NULL if the handle is null or stale.
+         */
+        const T* get(const crb::Graphics::Handle<T> handle) const
+        { return this->_isLive(handle) ? &this->values[handle.index] : NULL; }
+        /**
+         * @brief Adds a reference to a resource, so that it takes one more release() to remove it.
+         *
+         * @param handle The handle of the resource.
+         * @return True if the reference was added, false if the handle is null or stale.
+         */
+        bool retain(const crb::Graphics::Handle<T> handle)
+        {
+          if (!this->_isLive(handle))
+          {
+            return false;
+          }
+          this->references[handle.index]++;
+          return true;
+        }
+        /**
+         * @brief Drops a reference to a resource, removing it once no reference is left.
+         *
+         * @param handle The handle of the resource.
+         * @param oValue The removed resource, only set if the function returns true.
+         * @return True if that was the last reference and the resource was removed, false otherwise.
+         */
+        bool release(const crb::Graphics::Handle<T> handle, T& oValue)
+        {
+          if (!this->_isLive(handle) || --this->references[handle.index] > 0u)
+          {
+            return false;
+          }
+          return this->remove(handle, oValue);
+        }
+        /**
+         * @brief Removes a resource and frees its slot regardless of its references, invalidating every handle to it.
+         *
+         * @param handle The handle of the resource.
+         * @param oValue The removed resource.
+         * @return True if the resource was removed, false if the handle is null or stale.
+         */
+        bool remove(const crb::Graphics::Handle<T> handle, T& oValue)
+        {
+          if (!this->_isLive(handle))
+          {
+            return false;
+          }
+          oValue = this->values[handle.index];
+          this->values[handle.index] = T();
+          this->references[handle.index] = 0u;
+          this->generations[handle.index] = 0u;
+          this->freeSlots.push_back(handle.index);
+          return true;
+        }
+        /**
+         * @brief Removes every resource regardless of its references, invalidating every handle.
+         *
+         * @param oValues A vector the removed resources are appended to.
+         */
+        void removeAll(std::vector<T>& oValues)
+        {
+          for (std::uint32_t index = 0; index < this->values.size(); index++)
+          {
+            if (this->generations[index] != 0u)
+            {
+              this->remove({index, this->generations[index]}, oValues.emplace_back());
+            }
+          }
+        }
+
+      private:
+        /**
+         * @brief Internal method for checking whether a handle refers to the current resource of its slot.
+         *
+         * @param handle The handle.
+         * @return True if the handle is live, false if it is null or stale.
+         */
+        bool _isLive(const crb::Graphics::Handle<T> handle) const
+        {
+          return handle.generation != 0u
+            && handle.index < this->generations.size()
+            && this->generations[handle.index] == handle.generation;
+        }
+
+        inline static std::uint32_t nextGeneration {1u};
+
+        std::vector<T>             values;
+        std::vector<std::uint32_t> generations;
+        std::vector<std::uint32_t> references;
+        std::vector<std::uint32_t> freeSlots;
+    };
+
+    /**
+     * @brief A handle to the buffers of a mesh in the pool of the current context.
+     */
+    using MeshHandle = crb::Graphics::Handle<crb::Graphics::MeshBuffers>;
+    /**
+     * @brief A pool of mesh buffers, owned by the window of the OpenGL context they belong to.
+     */
+    using MeshPool = crb::Graphics::ResourcePool<crb::Graphics::MeshBuffers>;
+
+    /**
+     * @brief Makes a pool the one used by the mesh functions below, typically when its context is made current.
+     *
+     * @param pool The pool of the current context, or NULL if there is none.
+     */
+    void setMeshPool(crb::Graphics::MeshPool* pool);
+    /**
+     * @brief Deletes the buffers of every mesh left in a pool, invalidating their handles.
+     *
+     * Must be called while the context of the pool is still current. The pool stops being
+     * the current one if it was.
+     *
+     * @param pool The pool.
+     */
+    void releaseMeshPool(crb::Graphics::MeshPool& pool);
+
+    /**
+     * @brief Uploads a mesh into pooled buffers, reusing buffers released to a deletion queue if possible.
+     *
+     * The mesh is added to the pool of the current context, so this must only be called on the render thread.
+     *
+     * @param layout The layout of the vertices. Must outlive the mesh.
+     * @param vertices The vertex data.
+     * @param verticesSize The size of the vertex data in bytes.
+     * @param indices The index data.
+     * @param indicesSize The size of the index data in bytes.
+     * @param deletionQueue The queue to take recycled buffers from, or NULL to always create buffers.
+     * @return The handle of the mesh.
+     */
+    crb::Graphics::MeshHandle createMesh(const crb::Graphics::VertexLayout& layout, const void* vertices, const GLsizeiptr verticesSize, const GLuint indices[], const GLsizeiptr indicesSize, crb::Graphics::DeletionQueue* deletionQueue = NULL);
+    /**
+     * @brief Creates pooled buffers with uninitialized contents, to be filled piece by piece.
+     *
+     * @param layout The layout of the vertices. Must outlive the mesh.
+     * @param verticesSize The size of the vertex buffer in bytes.
+     * @param indicesSize The size of the index buffer in bytes.
+     * @param usage The expected usage of the buffers (e.g., GL_DYNAMIC_DRAW).
+     * @return The handle of the mesh.
+     */
+    crb::Graphics::MeshHandle createMesh(const crb::Graphics::VertexLayout& layout, const GLsizeiptr verticesSize, const GLsizeiptr indicesSize, const GLenum usage);
+    /**
+     * @brief Gets the buffers of a mesh.
+     *
+     * @param handle The handle of the mesh.
+     * @return A pointer to the buffers, or NULL if the handle is null or stale.
+     */
+    const crb::Graphics::MeshBuffers* getMesh(const crb::Graphics::MeshHandle handle);
+    /**
+     * @brief Adds a reference to a mesh, so that it is shared until every owner destroys it.
+     *
+     * @param handle The handle of the mesh.
+     * @return True if the reference was added, false if the handle is null or stale.
+     */
+    bool retainMesh(const crb::Graphics::MeshHandle handle);
+    /**
+     * @brief Drops a reference to a mesh, releasing its buffers and invalidating its handle once no reference is left.
+     *
+     * @param handle The handle of the mesh. Null and stale handles are ignored.
+     * @param deletionQueue The queue recycling the buffers, or NULL to delete them right away.
+     */
+    void destroyMesh(const crb::Graphics::MeshHandle handle, crb::Graphics::DeletionQueue* deletionQueue = NULL);
+    /**
+     * @brief Gets the number of live meshes, e.g. to detect leaks.
+     *
+     * @return The number of meshes created and not destroyed in the pool of the current context.
+     */
+    std::size_t getMeshCount();
+  }
+}
+
+#endif // CRB_RESOURCE_POOL_HPP
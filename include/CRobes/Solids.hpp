@@ -2,9 +2,15 @@
 #define CRB_SOLIDS_HPP
 
 #include <GL/glew.h>
+#include <cstddef>
+#include <vector>
 
+#include "DeletionQueue.hpp"
 #include "Graphics.hpp"
+#include "Profiler.hpp"
+#include "ResourcePool.hpp"
 #include "Space.hpp"
+#include "StreamBuffer.hpp"
 
 namespace crb
 {
@@ -13,8 +19,51 @@ namespace crb
    */
   namespace Solids
   {
+    /**
+     * @brief The vertex format of solids: position and texture coordinates, as floats.
+     */
+    using VertexFormat = crb::Graphics::VertexFormat<
+      crb::Graphics::Attribute<0, 3, GL_FLOAT>,
+      crb::Graphics::Attribute<1, 2, GL_FLOAT>
+    >;
+    /**
+     * @brief The number of floats per vertex of a solid.
+     */
+    constexpr std::size_t VERTEX_FLOATS {crb::Solids::VertexFormat::STRIDE / sizeof(GLfloat)};
+
+    /**
+     * @brief Vertex and index data of a solid, generated on the CPU and not yet uploaded.
+     * 
+     * Every vertex consists of VERTEX_FLOATS floats: position and texture coordinates.
+     */
+    struct Mesh
+    {
+      std::vector<GLfloat> vertices;
+      std::vector<GLuint>  indices;
+    };
+
+    /**
+     * @brief Computes the bounding box of vertex positions.
+     * 
+     * @param vertices An array of GLfloat containing vertex data, VERTEX_FLOATS floats per vertex.
+     * @param floatCount The number of floats in the array.
+     * @return The axis-aligned bounding box enclosing every vertex.
+     */
+    crb::Space::AABB computeBounds(const GLfloat vertices[], std::size_t floatCount);
+    /**
+     * @brief Moves every vertex of a mesh by an offset.
+     * 
+     * Used to bake the position of a solid into its vertices when it is drawn without a model matrix.
+     * 
+     * @param mesh The mesh to move.
+     * @param offset The offset added to every vertex position.
+     */
+    void translate(crb::Solids::Mesh& mesh, const crb::Space::Vec3& offset);
+
     /**
      * @brief A class representing a solid object in 3D space.
+     * 
+     * The solid owns a handle to its mesh buffers, so it is move-only and cheap to relocate.
      */
     class Solid
     {
@@ -27,101 +76,81 @@ namespace crb
          * @param verticesSize The size of the vertex data array.
          * @param indices An array of GLuint containing index data.
          * @param indicesSize The size of the index data array.
+         * @param deletionQueue The queue reusing and releasing the buffers, or NULL to own them directly. Must outlive the solid.
          */
-        Solid(const crb::Space::Vec3& position, GLfloat vertices[], GLsizeiptr verticesSize, GLuint indices[], GLsizeiptr indicesSize);
+        Solid(const crb::Space::Vec3& position, const GLfloat vertices[], GLsizeiptr verticesSize, const GLuint indices[], GLsizeiptr indicesSize, crb::Graphics::DeletionQueue* deletionQueue = NULL);
         /**
-         * @brief Destructor to release associated OpenGL resources.
+         * @brief Constructs a Solid object by uploading a generated mesh.
+         * 
+         * @param position The position of the solid in 3D space.
+         * @param mesh The vertex and index data of the solid.
+         * @param deletionQueue The queue reusing and releasing the buffers, or NULL to own them directly. Must outlive the solid.
          */
-        ~Solid()
-        {
-          if (this->VAO != NULL) this->VAO->Delete();
-          if (this->VBO != NULL) this->VBO->Delete();
-          if (this->EBO != NULL) this->EBO->Delete();
-        }
+        Solid(const crb::Space::Vec3& position, const crb::Solids::Mesh& mesh, crb::Graphics::DeletionQueue* deletionQueue = NULL)
+        : Solid(
+          position,
+          mesh.vertices.data(),
+          (GLsizeiptr)(mesh.vertices.size() * sizeof(GLfloat)),
+          mesh.indices.data(),
+          (GLsizeiptr)(mesh.indices.size() * sizeof(GLuint)),
+          deletionQueue
+        )
+        {}
         /**
-         * @brief Move constructor for Solid objects.
+         * @brief Constructs a Solid object drawing an already uploaded mesh, e.g. one shared through a MeshCache.
          *
-         * @param other Another Solid object.
+         * @param position The position of the solid in 3D space.
+         * @param mesh The handle of the mesh. The solid takes over one reference to it.
+         * @param bounds The bounding box of the mesh, relative to the position.
+         * @param vertexCount The number of indices to draw.
+         * @param deletionQueue The queue reusing and releasing the buffers, or NULL to own them directly. Must outlive the solid.
          */
-        Solid(crb::Solids::Solid&& other)
-        {
-          this->VAO = other.VAO;
-          this->VBO = other.VBO;
-          this->EBO = other.EBO;
-          this->position = other.position;
-          this->vertexCount = other.vertexCount;
-          
-          other.VAO = NULL;
-          other.VBO = NULL;
-          other.EBO = NULL;
-          other.position = {0.f};
-          other.vertexCount = 0;
-        }
+        Solid(const crb::Space::Vec3& position, const crb::Graphics::MeshHandle mesh, const crb::Space::AABB& bounds, const GLuint vertexCount, crb::Graphics::DeletionQueue* deletionQueue = NULL)
+        : position(position), bounds(bounds), mesh(mesh), deletionQueue(deletionQueue), vertexCount(vertexCount)
+        {}
         /**
-         * @brief Copy constructor for Solid objects.
-         *
-         * @param other Another Solid object.
+         * @brief Destructor to release associated OpenGL resources.
          */
-        Solid(const crb::Solids::Solid& other)
-        {
-          this->VAO = (other.VAO != NULL) ? new crb::Graphics::VAO(*other.VAO) : NULL;
-          this->VBO = (other.VBO != NULL) ? new crb::Graphics::VBO(*other.VBO) : NULL;
-          this->EBO = (other.EBO != NULL) ? new crb::Graphics::EBO(*other.EBO) : NULL;
-        
-          this->position = other.position;
-          this->vertexCount = other.vertexCount;
-        }
+        ~Solid()
+        { crb::Graphics::destroyMesh(this->mesh, this->deletionQueue); }
         /**
-         * @brief Copy assignment operator for Solid objects.
+         * @brief Move constructor for Solid objects.
          *
          * @param other Another Solid object.
-         * @return A reference to the assigned object.
          */
-        crb::Solids::Solid& operator=(const crb::Solids::Solid& other)
+        Solid(crb::Solids::Solid&& other) noexcept
+        : position(other.position), bounds(other.bounds), mesh(other.mesh), deletionQueue(other.deletionQueue), vertexCount(other.vertexCount)
         {
-          if (this != &other)
-          {
-            if (this->VAO != NULL) delete this->VAO;
-            if (this->VBO != NULL) delete this->VBO;
-            if (this->EBO != NULL) delete this->EBO;
-
-            this->VAO = (other.VAO != NULL) ? new crb::Graphics::VAO(*other.VAO) : NULL;
-            this->VBO = (other.VBO != NULL) ? new crb::Graphics::VBO(*other.VBO) : NULL;
-            this->EBO = (other.EBO != NULL) ? new crb::Graphics::EBO(*other.EBO) : NULL;
-          
-            this->position = other.position;
-            this->vertexCount = other.vertexCount;
-          }
-          return *this;
+          other.mesh = {};
+          other.position = {0.f};
+          other.vertexCount = 0;
         }
         /**
-         * @brief Copy assignment operator for Solid objects.
+         * @brief Move assignment operator for Solid objects.
          *
          * @param other Another Solid object.
          * @return A reference to the assigned object.
          */
-        crb::Solids::Solid& operator=(crb::Solids::Solid&& other)
+        crb::Solids::Solid& operator=(crb::Solids::Solid&& other) noexcept
         {
           if (this != &other)
           {
-            if (this->VAO != NULL) delete this->VAO;
-            if (this->VBO != NULL) delete this->VBO;
-            if (this->EBO != NULL) delete this->EBO;
+            crb::Graphics::destroyMesh(this->mesh, this->deletionQueue);
 
-            this->VAO = other.VAO;
-            this->VBO = other.VBO;
-            this->EBO = other.EBO;
             this->position = other.position;
+            this->bounds = other.bounds;
+            this->mesh = other.mesh;
+            this->deletionQueue = other.deletionQueue;
             this->vertexCount = other.vertexCount;
 
-            other.VAO = NULL;
-            other.VBO = NULL;
-            other.EBO = NULL;
+            other.mesh = {};
             other.position = {0.f};
             other.vertexCount = 0;
           }
           return *this;
         }
+        Solid(const crb::Solids::Solid& other) = delete;
+        crb::Solids::Solid& operator=(const crb::Solids::Solid& other) = delete;
 
         /**
          * @brief Gets the position of the solid.
@@ -151,6 +180,33 @@ namespace crb
          */
         float getZ() const
         { return this->position.z; }
+        /**
+         * @brief Gets the world-space bounding box of the solid.
+         * 
+         * @return The axis-aligned bounding box enclosing the solid.
+         */
+        crb::Space::AABB getBounds() const
+        { return {this->bounds.min + this->position, this->bounds.max + this->position}; }
+
+        /**
+         * @brief Gets the OpenGL ID of the solid's vertex array object.
+         * 
+         * @return The OpenGL ID of the VAO, or 0 if the solid was moved from.
+         */
+        GLuint getVertexArrayID() const
+        {
+          const crb::Graphics::MeshBuffers* buffers = crb::Graphics::getMesh(this->mesh);
+          return buffers != NULL ? buffers->vertexArray : 0u;
+        }
+
+        /**
+         * @brief Checks whether the solid is at least partially inside a view frustum.
+         * 
+         * @param frustum The view frustum to test against.
+         * @return True if the solid may be visible, false otherwise.
+         */
+        bool isVisible(const crb::Space::Frustum& frustum) const
+        { return frustum.intersects(this->getBounds()); }
 
         /**
          * @brief Renders the solid object using the specified shader program.
@@ -160,16 +216,106 @@ namespace crb
         void render(const crb::Graphics::Shader& shader, GLenum mode) const;
 
       private:
-        crb::Space::Mat4 model    {1.f};
         crb::Space::Vec3 position {0.f};
+        crb::Space::AABB bounds;
 
-        crb::Graphics::VAO* VAO {NULL};
-        crb::Graphics::VBO* VBO {NULL};
-        crb::Graphics::EBO* EBO {NULL};
+        crb::Graphics::MeshHandle     mesh;
+        crb::Graphics::DeletionQueue* deletionQueue {NULL};
 
         GLuint vertexCount {0};
     };
 
+    /**
+     * @brief A mesh drawn many times at different offsets with a single instanced draw call.
+     * 
+     * The mesh is uploaded once into the mesh pool. Per-instance offsets are read by attribute
+     * location 2 of the instanced vertex shader, and streamed every frame through a StreamBuffer.
+     */
+    class InstancedSolid
+    {
+      public:
+        /**
+         * @brief The attribute layout location of the per-instance offset.
+         */
+        static constexpr GLuint OFFSET_LAYOUT {2u};
+        /**
+         * @brief The number of instances the offset buffer holds per frame before it grows.
+         */
+        static constexpr std::size_t INSTANCE_CAPACITY {1024u};
+
+        /**
+         * @brief Constructs an InstancedSolid object by uploading the shared mesh.
+         * 
+         * @param mesh The vertex and index data shared by all instances.
+         */
+        InstancedSolid(const crb::Solids::Mesh& mesh);
+        /**
+         * @brief Destructor to release associated OpenGL resources.
+         */
+        ~InstancedSolid()
+        { crb::Graphics::destroyMesh(this->mesh); }
+        InstancedSolid(const crb::Solids::InstancedSolid& other) = delete;
+        crb::Solids::InstancedSolid& operator=(const crb::Solids::InstancedSolid& other) = delete;
+
+        /**
+         * @brief Gets the local bounding box of the shared mesh.
+         * 
+         * @return The axis-aligned bounding box of a single instance placed at the origin.
+         */
+        const crb::Space::AABB& getBounds() const
+        { return this->bounds; }
+        /**
+         * @brief Gets the OpenGL ID of the vertex array object.
+         * 
+         * @return The OpenGL ID of the VAO, or 0 if the mesh was released.
+         */
+        GLuint getVertexArrayID() const
+        {
+          const crb::Graphics::MeshBuffers* buffers = crb::Graphics::getMesh(this->mesh);
+          return buffers != NULL ? buffers->vertexArray : 0u;
+        }
+        /**
+         * @brief Gets the number of instances drawn by render().
+         * 
+         * @return The number of instances.
+         */
+        GLsizei getInstanceCount() const
+        { return this->instanceCount; }
+
+        /**
+         * @brief Uploads the offsets of the instances to draw. Meant to be called once per frame.
+         * 
+         * @param offsets The position of every instance.
+         */
+        void setInstances(const std::vector<crb::Space::Vec3>& offsets);
+        /**
+         * @brief Renders every instance with a single draw call.
+         * 
+         * @param shader The shader program to use for rendering.
+         * @param mode The primitive type to draw.
+         */
+        void render(const crb::Graphics::Shader& shader, GLenum mode) const;
+
+      private:
+        crb::Graphics::MeshHandle   mesh;
+        crb::Graphics::StreamBuffer instanceBuffer;
+
+        crb::Space::AABB bounds;
+
+        GLuint  vertexCount   {0};
+        GLsizei instanceCount {0};
+    };
+
+    /**
+     * @brief Collects the solids that are at least partially inside a view frustum.
+     * 
+     * @param solids The solids to test.
+     * @param frustum The view frustum to test against.
+     * @param oVisible A vector that is filled with pointers to the visible solids.
+     * @return The number of solids that were culled.
+     */
+    std::size_t cull(const std::vector<crb::Solids::Solid>& solids, const crb::Space::Frustum& frustum, std::vector<const crb::Solids::Solid*>& oVisible);
+
     /**
      * @brief A factory class for creating solid objects.
      */
@@ -182,6 +328,17 @@ namespace crb
         SolidFactory()
         {}
 
+        /**
+         * @brief Generates the mesh of a plane without uploading it.
+         * 
+         * Touches no OpenGL state, so it can run on a worker thread.
+         * 
+         * @param length The length of the plane.
+         * @param width The width of the plane.
+         * @param segmentCount The number of segments in the plane's geometry.
+         * @return The generated mesh.
+         */
+        crb::Solids::Mesh generatePlane(const float length, const float width, const unsigned int segmentCount) const;
         /**
          * @brief Creates a plane object.
          * 
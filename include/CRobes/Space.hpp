@@ -3,6 +3,15 @@
 
 #include <cmath>
 
+#include "Constants.hpp"
+
+#if !defined(CRB_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+  #define CRB_SIMD_SSE
+#endif
+#if defined(CRB_SIMD_SSE) && defined(__AVX__)
+  #define CRB_SIMD_AVX
+#endif
+
 namespace crb
 {
   /**
@@ -24,6 +33,17 @@ namespace crb
     inline float radians(const float degrees)
     { return degrees * crb::Space::PI / 180.f; }
 
+    /**
+     * @brief The name of the instruction set used by the matrix kernels.
+     */
+#if defined(CRB_SIMD_AVX)
+    inline const char* SIMD_BACKEND = "AVX";
+#elif defined(CRB_SIMD_SSE)
+    inline const char* SIMD_BACKEND = "SSE";
+#else
+    inline const char* SIMD_BACKEND = "Scalar";
+#endif
+
     /**
      * @class Vec3
      * @brief Represents a 3D vector.
@@ -335,6 +355,58 @@ namespace crb
         float y {0.f};
     };
 
+    /**
+     * @class Vec4
+     * @brief Represents a 4D vector.
+     * 
+     * This class represents a homogeneous vector with x, y, z and w components.
+     * It is aligned to 16 bytes so it can be loaded directly into SIMD registers.
+     */
+    class alignas(16) Vec4
+    {
+      public:
+        /**
+         * @brief Constructs a Vec4 object with the specified x, y, z and w components.
+         * 
+         * @param x The x component of the vector.
+         * @param y The y component of the vector.
+         * @param z The z component of the vector.
+         * @param w The w component of the vector.
+         */
+        Vec4(const float x, const float y, const float z, const float w)
+        : x(x), y(y), z(z), w(w)
+        {}
+        /**
+         * @brief Constructs a Vec4 object from a Vec3 object and a w component.
+         * 
+         * @param vec The x, y and z components of the vector.
+         * @param w The w component of the vector.
+         */
+        Vec4(const crb::Space::Vec3& vec, const float w)
+        : x(vec.x), y(vec.y), z(vec.z), w(w)
+        {}
+        /**
+         * @brief Default constructor.
+         * 
+         * Initializes the vector to (0, 0, 0, 0).
+         */
+        Vec4()
+        {}
+        /**
+         * @brief Constructs a Vec4 object with all components set to the same scalar value.
+         * 
+         * @param scalar The scalar value to set for all components.
+         */
+        Vec4(const float scalar)
+        : x(scalar), y(scalar), z(scalar), w(scalar)
+        {}
+
+        float x {0.f};
+        float y {0.f};
+        float z {0.f};
+        float w {0.f};
+    };
+
     /**
      * @brief Calculates the length of a 2D vector.
      * 
@@ -342,7 +414,7 @@ namespace crb
      * @return The length of the vector.
      */
     inline float lengthOf(const crb::Space::Vec2& vec)
-    { return sqrtf(pow(vec.x, 2) + pow(vec.y, 2)); }
+    { return sqrtf(vec.x * vec.x + vec.y * vec.y); }
     /**
      * @brief Calculates the length of a 3D vector.
      * 
@@ -350,7 +422,7 @@ namespace crb
      * @return The length of the vector.
      */
     inline float lengthOf(const crb::Space::Vec3& vec)
-    { return sqrtf(pow(vec.x, 2) + pow(vec.y, 2) + pow(vec.z, 2)); }
+    { return sqrtf(vec.x * vec.x + vec.y * vec.y + vec.z * vec.z); }
     /**
      * @brief Normalizes a 2D vector.
      * 
@@ -576,27 +648,91 @@ namespace crb
          * @param mat The matrix to multiply by.
          * @return The resulting matrix.
          */
-        crb::Space::Mat4 operator*(const crb::Space::Mat4& mat)
-        {
-          crb::Space::Mat4 result;
-          for (int i = 0; i < 4; i++)
-          {
-            for (int j = 0; j < 4; j++)
-            {
-              result[i][j] = 0.f;
-              for (int k = 0; k < 4; k++)
-              {
-                result[i][j] += this->elements[i][k] * mat[k][j];
-              }
-            }
-          }
-          return result;
-        }
+        crb::Space::Mat4 operator*(const crb::Space::Mat4& mat);
+        /**
+         * @brief Transforms a vector by this matrix.
+         * 
+         * Equivalent to `matrix * vector` in the shaders.
+         * 
+         * @param vec The vector to transform.
+         * @return The transformed vector.
+         */
+        crb::Space::Vec4 operator*(const crb::Space::Vec4& vec);
 
       private:
-        float elements[4][4];
+        alignas(16) float elements[4][4];
     };
 
+    /**
+     * @brief Multiplies two matrices using the fastest available kernel.
+     * 
+     * @param matOne The left-hand matrix.
+     * @param matTwo The right-hand matrix.
+     * @return The resulting matrix.
+     */
+    crb::Space::Mat4 multiply(const crb::Space::Mat4& matOne, const crb::Space::Mat4& matTwo);
+    /**
+     * @brief Transforms a vector by a matrix using the fastest available kernel.
+     * 
+     * @param mat The transformation matrix.
+     * @param vec The vector to transform.
+     * @return The transformed vector.
+     */
+    crb::Space::Vec4 transform(const crb::Space::Mat4& mat, const crb::Space::Vec4& vec);
+    /**
+     * @brief Inverts an affine matrix using the fastest available kernel.
+     * 
+     * The matrix must consist of a 3x3 linear part and a translation only.
+     * 
+     * @param mat The affine matrix to invert.
+     * @return The inverted matrix.
+     */
+    crb::Space::Mat4 affineInverse(const crb::Space::Mat4& mat);
+    /**
+     * @brief Inverts an arbitrary matrix using the fastest available kernel.
+     * 
+     * @param mat The matrix to invert.
+     * @return The inverted matrix, or a zero matrix if it is singular.
+     */
+    crb::Space::Mat4 inverse(const crb::Space::Mat4& mat);
+
+    /**
+     * @brief Contains the portable reference implementations of the matrix kernels.
+     */
+    namespace Scalar
+    {
+      /**
+       * @brief Multiplies two matrices.
+       * 
+       * @param matOne The left-hand matrix.
+       * @param matTwo The right-hand matrix.
+       * @return The resulting matrix.
+       */
+      crb::Space::Mat4 multiply(const crb::Space::Mat4& matOne, const crb::Space::Mat4& matTwo);
+      /**
+       * @brief Transforms a vector by a matrix.
+       * 
+       * @param mat The transformation matrix.
+       * @param vec The vector to transform.
+       * @return The transformed vector.
+       */
+      crb::Space::Vec4 transform(const crb::Space::Mat4& mat, const crb::Space::Vec4& vec);
+      /**
+       * @brief Inverts an affine matrix.
+       * 
+       * @param mat The affine matrix to invert.
+       * @return The inverted matrix.
+       */
+      crb::Space::Mat4 affineInverse(const crb::Space::Mat4& mat);
+      /**
+       * @brief Inverts an arbitrary matrix.
+       * 
+       * @param mat The matrix to invert.
+       * @return The inverted matrix, or a zero matrix if it is singular.
+       */
+      crb::Space::Mat4 inverse(const crb::Space::Mat4& mat);
+    }
+
     /**
      * @brief Retrieves a pointer to the first element of a matrix for OpenGL usage.
      * 
@@ -651,6 +787,83 @@ namespace crb
      * @return The view matrix.
      */
     crb::Space::Mat4 lookAt(const crb::Space::Vec3& eye, const crb::Space::Vec3& target, const crb::Space::Vec3& up);
+
+    /**
+     * @brief Represents an axis-aligned bounding box.
+     */
+    struct AABB
+    {
+      crb::Space::Vec3 min {0.f};
+      crb::Space::Vec3 max {0.f};
+    };
+
+    /**
+     * @brief Represents a plane as a normal and a signed distance from the origin.
+     * 
+     * Points for which `dot(normal, point) + distance` is positive lie in front of the plane.
+     */
+    struct Plane
+    {
+      crb::Space::Vec3 normal {0.f};
+      float distance {0.f};
+    };
+
+    /**
+     * @class Frustum
+     * @brief Represents a view frustum bounded by six inward-facing planes.
+     */
+    class Frustum
+    {
+      public:
+        /**
+         * @brief Indices of the frustum planes.
+         */
+        enum Side
+        {
+          Left,
+          Right,
+          Bottom,
+          Top,
+          Near,
+          Far,
+        };
+
+        /**
+         * @brief Gets one of the frustum planes.
+         * 
+         * @param side The side of the plane.
+         * @return The plane on the specified side.
+         */
+        const crb::Space::Plane& getPlane(const crb::Space::Frustum::Side side) const
+        { return this->planes[side]; }
+        /**
+         * @brief Sets one of the frustum planes.
+         * 
+         * @param side The side of the plane.
+         * @param plane The new plane.
+         */
+        void setPlane(const crb::Space::Frustum::Side side, const crb::Space::Plane& plane)
+        { this->planes[side] = plane; }
+
+        /**
+         * @brief Checks whether a bounding box is at least partially inside the frustum.
+         * 
+         * @param box The bounding box to test.
+         * @return True if the box may be visible, false if it is entirely outside.
+         */
+        bool intersects(const crb::Space::AABB& box) const;
+
+      private:
+        crb::Space::Plane planes[6];
+    };
+
+    /**
+     * @brief Extracts the view frustum from a combined view-projection matrix.
+     * 
+     * @param mat The view-projection matrix.
+     * @return The frustum with normalized planes.
+     */
+    crb::Space::Frustum extractFrustum(const crb::Space::Mat4& mat);
   }
 }
 
@@ -0,0 +1,187 @@
+#ifndef CRB_STATE_HPP
+#define CRB_STATE_HPP
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace crb
+{
+  namespace Graphics
+  {
+    /**
+     * @brief A shadow copy of the OpenGL binding state, used to drop redundant state changes.
+     *
+     * Every binding made by the engine goes through these functions. Code that changes the
+     * same state with raw OpenGL calls must call invalidate() afterwards. Only valid on the
+     * thread owning the OpenGL context.
+     *
+     * Every context has its own bindings, so the shadow copy lives in a Cache owned by the
+     * window of the context, and the functions act on the cache set by setCache().
+     */
+    namespace State
+    {
+      /**
+       * @brief The shadow copy of the bindings of one OpenGL context.
+       */
+      struct Cache
+      {
+        /**
+         * @brief Marks a binding whose value is not known, so that the next change is always issued.
+         */
+        static constexpr GLuint UNKNOWN {0xFFFFFFFFu};
+
+        GLuint program           {UNKNOWN};
+        GLuint vertexArray       {UNKNOWN};
+        GLuint activeTextureUnit {UNKNOWN};
+        GLenum polygonMode       {GL_NONE};
+        GLuint depthMask         {UNKNOWN};
+
+        // Enabled capabilities (e.g., GL_DEPTH_TEST) by name
+        std::unordered_map<GLenum, GLuint> capabilities;
+
+        // Buffer bindings by target, element array buffers by vertex array object
+        std::unordered_map<GLenum, GLuint> buffers;
+        std::unordered_map<GLuint, GLuint> elementBuffers;
+        // Texture bindings by unit and target
+        std::unordered_map<std::uint64_t, GLuint> textures;
+
+        std::size_t issuedCalls {0u};
+        std::size_t savedCalls  {0u};
+      };
+
+      /**
+       * @brief Sets the cache the state functions act on, usually when a context is made current.
+       *
+       * @param cache The cache of the current context, or NULL to fall back to a process-wide cache.
+       */
+      void setCache(crb::Graphics::State::Cache* cache);
+
+      /**
+       * @brief Makes a shader program current, unless it already is.
+       *
+       * @param program The OpenGL ID of the shader program.
+       */
+      void useProgram(GLuint program);
+      /**
+       * @brief Binds a vertex array object, unless it already is.
+       *
+       * @param vertexArray The OpenGL ID of the vertex array object.
+       */
+      void bindVertexArray(GLuint vertexArray);
+      /**
+       * @brief Binds a buffer object to a target, unless it already is.
+       *
+       * The element array buffer binding is tracked per vertex array object.
+       *
+       * @param target The buffer target (e.g., GL_ARRAY_BUFFER).
+       * @param buffer The OpenGL ID of the buffer object.
+       */
+      void bindBuffer(GLenum target, GLuint buffer);
+      /**
+       * @brief Binds a buffer object to an indexed binding point.
+       *
+       * Always issued, but recorded since it also changes the generic binding of the target.
+       *
+       * @param target The indexed buffer target (e.g., GL_UNIFORM_BUFFER).
+       * @param index The binding point.
+       * @param buffer The OpenGL ID of the buffer object.
+       */
+      void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+      /**
+       * @brief Selects the active texture unit, unless it already is.
+       *
+       * @param unit The index of the texture unit, starting at 0.
+       */
+      void setActiveTextureUnit(GLuint unit);
+      /**
+       * @brief Binds a texture to the active texture unit, unless it already is.
+       *
+       * @param target The texture target (e.g., GL_TEXTURE_2D).
+       * @param texture The OpenGL ID of the texture.
+       */
+      void bindTexture(GLenum target, GLuint texture);
+      /**
+       * @brief Sets the polygon rasterization mode of both faces, unless it already is.
+       *
+       * @param mode The polygon mode (e.g., GL_LINE).
+       */
+      void setPolygonMode(GLenum mode);
+      /**
+       * @brief Enables or disables depth writes, unless they already are.
+       *
+       * @param enabled GL_TRUE to write depth values, GL_FALSE otherwise.
+       */
+      void setDepthMask(GLboolean enabled);
+      /**
+       * @brief Enables or disables a capability, unless it already is.
+       *
+       * @param capability The capability (e.g., GL_DEPTH_TEST).
+       * @param enabled True to enable the capability, false to disable it.
+       */
+      void setCapability(GLenum capability, bool enabled);
+      /**
+       * @brief Gets whether depth writes are enabled, querying OpenGL if it is not known yet.
+       *
+       * @return GL_TRUE if depth values are written, GL_FALSE otherwise.
+       */
+      GLboolean getDepthMask();
+      /**
+       * @brief Checks if a capability is enabled, querying OpenGL if it is not known yet.
+       *
+       * @param capability The capability (e.g., GL_DEPTH_TEST).
+       * @return True if the capability is enabled, false otherwise.
+       */
+      bool isCapabilityEnabled(GLenum capability);
+
+      /**
+       * @brief Forgets a deleted shader program.
+       *
+       * @param program The OpenGL ID of the shader program.
+       */
+      void forgetProgram(GLuint program);
+      /**
+       * @brief Forgets a deleted vertex array object.
+       *
+       * @param vertexArray The OpenGL ID of the vertex array object.
+       */
+      void forgetVertexArray(GLuint vertexArray);
+      /**
+       * @brief Forgets a deleted buffer object.
+       *
+       * @param buffer The OpenGL ID of the buffer object.
+       */
+      void forgetBuffer(GLuint buffer);
+      /**
+       * @brief Forgets a deleted texture.
+       *
+       * @param texture The OpenGL ID of the texture.
+       */
+      void forgetTexture(GLuint texture);
+      /**
+       * @brief Forgets the whole shadow state, so that the next change of every state is issued.
+       */
+      void invalidate();
+
+      /**
+       * @brief Gets the number of state changes passed on to OpenGL since the counters were reset.
+       *
+       * @return The number of issued OpenGL calls.
+       */
+      std::size_t getIssuedCallCount();
+      /**
+       * @brief Gets the number of redundant state changes dropped since the counters were reset.
+       *
+       * @return The number of saved OpenGL calls.
+       */
+      std::size_t getSavedCallCount();
+      /**
+       * @brief Resets the issued and saved call counters, usually once per frame.
+       */
+      void resetCallCounts();
+    }
+  }
+}
+
+#endif // CRB_STATE_HPP
@@ -0,0 +1,161 @@
+#ifndef CRB_STREAM_BUFFER_HPP
+#define CRB_STREAM_BUFFER_HPP
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <vector>
+
+#include "State.hpp"
+
+namespace crb
+{
+  namespace Graphics
+  {
+    /**
+     * @class StreamBuffer
+     * @brief A buffer for data that is written again every frame.
+     *
+     * With ARB_buffer_storage, the buffer is mapped once, persistently and coherently, and
+     * split into FRAME_COUNT regions used in turn. Data is written straight into the mapping,
+     * and a fence per region makes sure the GPU is done reading a region before it is written
+     * again, so there is neither a copy nor any synchronization in the driver. Without the
+     * extension, the buffer holds a single region that is orphaned every frame and mapped
+     * without synchronization.
+     *
+     * Each frame starts with nextFrame(), followed by any number of map() and unmap() pairs.
+     * The draws reading the data must be submitted before the next call to nextFrame().
+     */
+    class StreamBuffer
+    {
+      public:
+        /**
+         * @brief The number of regions of a persistent buffer, so the number of frames in flight.
+         */
+        static constexpr std::size_t FRAME_COUNT {3u};
+
+        /**
+         * @brief Checks whether persistent mapping is available in the current context.
+         *
+         * @return True if ARB_buffer_storage is supported, false otherwise.
+         */
+        static bool isPersistentSupported();
+
+        /**
+         * @brief Constructs a StreamBuffer object.
+         *
+         * @param target The target the buffer is bound to (e.g., GL_ARRAY_BUFFER).
+         * @param frameSize The number of bytes that can be written per frame. Grows when exceeded.
+         */
+        StreamBuffer(const GLenum target, const GLsizeiptr frameSize);
+        /**
+         * @brief Destructor to release associated OpenGL resources.
+         */
+        ~StreamBuffer();
+        StreamBuffer(const crb::Graphics::StreamBuffer& other) = delete;
+        crb::Graphics::StreamBuffer& operator=(const crb::Graphics::StreamBuffer& other) = delete;
+
+        /**
+         * @brief Gets the OpenGL ID of the buffer.
+         *
+         * @return The OpenGL ID of the buffer. Changes when the buffer grows.
+         */
+        GLuint getID() const
+        { return this->ID; }
+        /**
+         * @brief Gets the number of bytes that can be written per frame.
+         *
+         * @return The size of a region in bytes.
+         */
+        GLsizeiptr getFrameSize() const
+        { return this->frameSize; }
+        /**
+         * @brief Checks whether the buffer is persistently mapped.
+         *
+         * @return True if the buffer is persistently mapped, false if it is orphaned every frame.
+         */
+        bool isPersistent() const
+        { return this->persistent; }
+        /**
+         * @brief Gets the number of times nextFrame() had to wait for the GPU.
+         *
+         * @return The number of stalls, which stays at 0 while the GPU keeps up.
+         */
+        std::size_t getStallCount() const
+        { return this->stallCount; }
+
+        /**
+         * @brief Binds the buffer to its target.
+         */
+        void Bind() const
+        { crb::Graphics::State::bindBuffer(this->target, this->ID); }
+        /**
+         * @brief Unbinds the buffer from its target.
+         */
+        void Unbind() const
+        { crb::Graphics::State::bindBuffer(this->target, 0); }
+
+        /**
+         * @brief Moves on to the region of the next frame, waiting until the GPU is done reading it.
+         */
+        void nextFrame();
+        /**
+         * @brief Reserves space in the region of the current frame.
+         *
+         * The buffer grows when the region is full. Data written earlier in the frame stays in
+         * the previous buffer, which is fenced by the next call to nextFrame() and only deleted
+         * once that fence has signaled.
+         *
+         * @param size The number of bytes to write.
+         * @param alignment The alignment of the offset, e.g. the vertex stride, so that it can be used as a base vertex.
+         * @param oOffset The offset of the reserved space in the buffer.
+         * @return A pointer to write the data to, until unmap() is called, or NULL if mapping failed.
+         */
+        void* map(const GLsizeiptr size, const GLsizeiptr alignment, GLintptr& oOffset);
+        /**
+         * @brief Ends the writes of the last map(). Has to be called before drawing from the buffer.
+         */
+        void unmap();
+
+      private:
+        /**
+         * @brief Internal method for creating the buffer and its mapping.
+         */
+        void _create();
+        /**
+         * @brief Internal method for deleting the buffer and its fences.
+         *
+         * @param retire Whether to keep the buffer until the GPU is done with it, rather than deleting it right away.
+         */
+        void _release(const bool retire = false);
+        /**
+         * @brief Internal method for fencing the retired buffers and deleting the ones the GPU is done with.
+         */
+        void _collectRetired();
+
+        struct Retired
+        {
+          GLuint ID    {0u};
+          GLsync fence {NULL};
+        };
+
+        GLuint     ID         {0u};
+        GLenum     target     {GL_ARRAY_BUFFER};
+        GLsizeiptr frameSize  {0};
+        bool       persistent {false};
+        bool       mapped     {false};
+
+        // Only used by persistent buffers
+        char*       mapping    {NULL};
+        GLsync      fences[FRAME_COUNT] {};
+        std::size_t region     {0u};
+        std::size_t stallCount {0u};
+
+        GLsizeiptr cursor {0};
+
+        // Buffers replaced by a larger one, still read by in-flight draws
+        std::vector<Retired> retired;
+    };
+  }
+}
+
+#endif // CRB_STREAM_BUFFER_HPP
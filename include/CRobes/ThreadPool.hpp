@@ -0,0 +1,80 @@
+#ifndef CRB_THREAD_POOL_HPP
+#define CRB_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Profiler.hpp"
+
+namespace crb
+{
+  /**
+   * @class ThreadPool
+   * @brief A fixed set of worker threads executing queued jobs.
+   * 
+   * Jobs must not touch OpenGL, since the context is only current on the render thread.
+   */
+  class ThreadPool
+  {
+    public:
+      /**
+       * @brief Constructs a ThreadPool object and starts its worker threads.
+       * 
+       * @param threadCount The number of worker threads. Zero picks one less than the number of hardware threads.
+       */
+      explicit ThreadPool(const unsigned int threadCount = 0u);
+      /**
+       * @brief Destroys the ThreadPool object.
+       * 
+       * Jobs that have not started yet are discarded, running jobs are waited for.
+       */
+      ~ThreadPool();
+      ThreadPool(const crb::ThreadPool& other) = delete;
+      crb::ThreadPool& operator=(const crb::ThreadPool& other) = delete;
+
+      /**
+       * @brief Gets the number of worker threads.
+       * 
+       * @return The number of worker threads.
+       */
+      std::size_t getThreadCount() const
+      { return this->workers.size(); }
+      /**
+       * @brief Gets the number of jobs waiting for a worker.
+       * 
+       * @return The number of queued jobs.
+       */
+      std::size_t getQueuedCount()
+      {
+        std::lock_guard<std::mutex> lock {this->mutex};
+        return this->jobs.size();
+      }
+
+      /**
+       * @brief Queues a job for execution on a worker thread.
+       * 
+       * @param job The job to execute.
+       */
+      void submit(std::function<void()> job);
+
+    private:
+      std::vector<std::thread>          workers;
+      std::deque<std::function<void()>> jobs;
+
+      std::mutex              mutex;
+      std::condition_variable condition;
+      bool                    stopping {false};
+
+      /**
+       * @brief Internal method run by every worker thread.
+       */
+      void _work();
+  };
+}
+
+#endif // CRB_THREAD_POOL_HPP
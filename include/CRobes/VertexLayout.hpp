@@ -0,0 +1,222 @@
+#ifndef CRB_VERTEX_LAYOUT_HPP
+#define CRB_VERTEX_LAYOUT_HPP
+
+#include <GL/glew.h>
+#include <cstddef>
+
+namespace crb
+{
+  namespace Graphics
+  {
+    /**
+     * @brief Gets the size of a single vertex attribute component.
+     *
+     * @param type The OpenGL data type of the component (e.g., GL_HALF_FLOAT).
+     * @return The size of the component in bytes, or 0 if the type is not supported.
+     */
+    constexpr GLsizei getTypeSize(const GLenum type)
+    {
+      switch (type)
+      {
+        case GL_BYTE:
+        case GL_UNSIGNED_BYTE:
+          return 1;
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT:
+        case GL_HALF_FLOAT:
+          return 2;
+        case GL_INT:
+        case GL_UNSIGNED_INT:
+        case GL_FLOAT:
+        case GL_INT_2_10_10_10_REV:
+        case GL_UNSIGNED_INT_2_10_10_10_REV:
+          return 4;
+        case GL_DOUBLE:
+          return 8;
+        default:
+          return 0;
+      }
+    }
+
+    /**
+     * @brief Converts a float to a half float, rounding to the nearest value.
+     *
+     * @param value The value to convert.
+     * @return The bits of the half float, as read by GL_HALF_FLOAT attributes.
+     */
+    GLhalf toHalf(const float value);
+    /**
+     * @brief Converts a value between 0 and 1 to a normalized unsigned byte.
+     *
+     * @param value The value to convert, clamped to [0, 1].
+     * @return The byte, read back as the value by normalized GL_UNSIGNED_BYTE attributes.
+     */
+    constexpr GLubyte toUnorm8(const float value)
+    { return (GLubyte)((value <= 0.f ? 0.f : value >= 1.f ? 1.f : value) * 255.f + 0.5f); }
+    /**
+     * @brief Converts a value between 0 and 1 to a normalized unsigned short.
+     *
+     * @param value The value to convert, clamped to [0, 1].
+     * @return The short, read back as the value by normalized GL_UNSIGNED_SHORT attributes.
+     */
+    constexpr GLushort toUnorm16(const float value)
+    { return (GLushort)((value <= 0.f ? 0.f : value >= 1.f ? 1.f : value) * 65535.f + 0.5f); }
+    /**
+     * @brief Converts a value between -1 and 1 to a normalized signed short.
+     *
+     * @param value The value to convert, clamped to [-1, 1].
+     * @return The short, read back as the value by normalized GL_SHORT attributes.
+     */
+    constexpr GLshort toSnorm16(const float value)
+    {
+      return (GLshort)((value <= -1.f ? -1.f : value >= 1.f ? 1.f : value) * 32767.f
+        + (value < 0.f ? -0.5f : 0.5f));
+    }
+
+    /**
+     * @brief A single attribute of a vertex, as passed to glVertexAttribPointer.
+     */
+    struct VertexAttribute
+    {
+      GLuint    location   {0u};
+      GLint     size       {0};
+      GLenum    type       {GL_FLOAT};
+      GLboolean normalized {GL_FALSE};
+      GLsizei   offset     {0};
+    };
+
+    /**
+     * @class VertexLayout
+     * @brief Describes how the attributes of a vertex are laid out in a vertex buffer.
+     *
+     * Attributes are packed in the order they are added, without padding, and the stride
+     * is the size of the whole vertex. The class is a literal type, so layouts can be
+     * built and checked at compile time, see VertexFormat.
+     */
+    class VertexLayout
+    {
+      public:
+        /**
+         * @brief The maximum number of attributes of a layout.
+         */
+        static constexpr std::size_t MAX_ATTRIBUTES {8u};
+
+        /**
+         * @brief Constructs an empty VertexLayout object.
+         */
+        constexpr VertexLayout()
+        {}
+
+        /**
+         * @brief Gets the size of a vertex.
+         *
+         * @return The stride between consecutive vertices in bytes.
+         */
+        constexpr GLsizei getStride() const
+        { return this->stride; }
+        /**
+         * @brief Gets the number of attributes.
+         *
+         * @return The number of attributes.
+         */
+        constexpr std::size_t getAttributeCount() const
+        { return this->attributeCount; }
+        /**
+         * @brief Gets an attribute.
+         *
+         * @param index The index of the attribute, in the order it was added.
+         * @return The attribute.
+         */
+        constexpr const crb::Graphics::VertexAttribute& getAttribute(const std::size_t index) const
+        { return this->attributes[index]; }
+
+        /**
+         * @brief Appends an attribute after the previous ones. Attributes past MAX_ATTRIBUTES are ignored.
+         *
+         * @param location The attribute layout location.
+         * @param size The number of components of the attribute.
+         * @param type The data type of each component.
+         * @param normalized Whether integer components are mapped to [0, 1] or [-1, 1] instead of converted directly.
+         * @return A reference to the layout, so that calls can be chained.
+         */
+        constexpr crb::Graphics::VertexLayout& add(const GLuint location, const GLint size, const GLenum type, const GLboolean normalized = GL_FALSE)
+        {
+          if (this->attributeCount < MAX_ATTRIBUTES)
+          {
+            this->attributes[this->attributeCount] = {location, size, type, normalized, this->stride};
+            this->attributeCount++;
+            this->stride += size * crb::Graphics::getTypeSize(type);
+          }
+          return *this;
+        }
+        /**
+         * @brief Sets the attribute pointers of the bound vertex array object to the bound array buffer.
+         */
+        void apply() const;
+
+      private:
+        crb::Graphics::VertexAttribute attributes[MAX_ATTRIBUTES] {};
+        std::size_t                    attributeCount {0u};
+        GLsizei                        stride         {0};
+    };
+
+    /**
+     * @brief An attribute of a VertexFormat.
+     *
+     * @tparam Location The attribute layout location.
+     * @tparam Size The number of components of the attribute.
+     * @tparam Type The data type of each component.
+     * @tparam Normalized Whether integer components are normalized.
+     */
+    template <GLuint Location, GLint Size, GLenum Type, GLboolean Normalized = GL_FALSE>
+    struct Attribute
+    {
+      static_assert(Size >= 1 && Size <= 4, "Vertex attributes have 1 to 4 components");
+      static_assert(crb::Graphics::getTypeSize(Type) > 0, "Unsupported vertex attribute type");
+
+      static constexpr GLuint    LOCATION   {Location};
+      static constexpr GLint     SIZE       {Size};
+      static constexpr GLenum    TYPE       {Type};
+      static constexpr GLboolean NORMALIZED {Normalized};
+    };
+
+    /**
+     * @brief Builds the layout of a list of attributes.
+     *
+     * @tparam Attributes The attributes in buffer order, as Attribute types.
+     * @return The layout.
+     */
+    template <typename... Attributes>
+    constexpr crb::Graphics::VertexLayout makeVertexLayout()
+    {
+      crb::Graphics::VertexLayout layout;
+      (layout.add(Attributes::LOCATION, Attributes::SIZE, Attributes::TYPE, Attributes::NORMALIZED), ...);
+      return layout;
+    }
+
+    /**
+     * @brief A vertex layout fixed at compile time.
+     *
+     * Lets the vertex struct of a mesh be checked against its layout, e.g.
+     * static_assert(sizeof(Vertex) == Format::STRIDE).
+     *
+     * @tparam Attributes The attributes in buffer order, as Attribute types.
+     */
+    template <typename... Attributes>
+    struct VertexFormat
+    {
+      static_assert(sizeof...(Attributes) <= crb::Graphics::VertexLayout::MAX_ATTRIBUTES, "Too many vertex attributes");
+
+      /**
+       * @brief The runtime description of the format, as passed to VAO::LinkLayout().
+       */
+      static constexpr crb::Graphics::VertexLayout LAYOUT {crb::Graphics::makeVertexLayout<Attributes...>()};
+      /**
+       * @brief The size of a vertex in bytes.
+       */
+      static constexpr GLsizei STRIDE {LAYOUT.getStride()};
+    };
+  }
+}
+
+#endif // CRB_VERTEX_LAYOUT_HPP
@@ -4,13 +4,20 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <string>
 
 #include "Core.hpp"
 #include "Color.hpp"
 #include "Input.hpp"
+#include "Profiler.hpp"
 #include "Camera.hpp"
+#include "CameraPath.hpp"
+#include "FrameCapture.hpp"
+#include "FrameStats.hpp"
+#include "RenderQueue.hpp"
+#include "ResourcePool.hpp"
 
 namespace crb
 {
@@ -25,24 +32,55 @@ namespace crb
   class Window
   {
     public:
+      /**
+       * @brief The ways a window can present its frames.
+       */
+      enum Mode
+      {
+        Windowed,
+        Headless,
+      };
+
+      /**
+       * @brief The number of frames a headless window lets the GPU fall behind by.
+       */
+      static constexpr std::size_t FRAMES_IN_FLIGHT {2u};
+
       /**
        * @brief Constructs a Window object with the specified width, height, and title.
        *
+       * A headless window renders into an offscreen framebuffer of the given size and never
+       * waits for vertical sync. It uses a surfaceless EGL context when EGL is available, so
+       * it needs no display server, and a hidden GLFW window otherwise.
+       *
        * @param width The width of the window.
        * @param height The height of the window.
        * @param title The title of the window.
+       * @param mode Whether to show the window or render offscreen.
        */
-      Window(const unsigned int width, const unsigned int height, const std::string& title)
-      : width(width), height(height), title(title)
+      Window(const unsigned int width, const unsigned int height, const std::string& title, const crb::Window::Mode mode = crb::Window::Windowed)
+      : width(width), height(height), title(title), mode(mode)
       { this->_initialize(); }
       /**
        * @brief Destroys the Window object.
        * 
-       * This method cleans up resources associated with the window.
+       * This method cleans up resources associated with the window. Meshes that are still
+       * alive are released with the context, and their handles become stale.
        */
       virtual ~Window()
       {
+        this->makeContextCurrent();
+        if (this->cameraBuffer != NULL)
+        {
+          this->cameraBuffer->Delete();
+          delete this->cameraBuffer;
+        }
+        delete this->gpuTimer;
+        delete this->frameCapture;
+        crb::Graphics::releaseMeshPool(this->meshPool);
+        this->_releaseHeadless();
         glfwDestroyWindow(this->glfwInstance);
+        crb::Graphics::State::setCache(NULL);
       }
 
       /**
@@ -66,6 +104,20 @@ namespace crb
        */
       std::string getTitle() const
       { return this->title; }
+      /**
+       * @brief Gets the mode of the window.
+       *
+       * @return Whether the window is shown or renders offscreen.
+       */
+      crb::Window::Mode getMode() const
+      { return this->mode; }
+      /**
+       * @brief Gets the framebuffer the window renders into.
+       *
+       * @return The ID of the offscreen framebuffer of a headless window, 0 for the default framebuffer.
+       */
+      GLuint getFramebufferID() const
+      { return this->framebuffer; }
       /**
        * @brief Gets the clear color used for rendering.
        * 
@@ -87,6 +139,44 @@ namespace crb
        */
       int getFPS() const
       { return round(1.f / this->deltaTime); }
+      /**
+       * @brief Gets the capture saving frames rendered by the window to PNG files.
+       * 
+       * @return A reference to the frame capture.
+       */
+      crb::FrameCapture& getFrameCapture()
+      { return *this->frameCapture; }
+      /**
+       * @brief Gets the statistics of the frame times.
+       * 
+       * @return A reference to the frame statistics.
+       */
+      crb::FrameStats& getFrameStats()
+      { return this->frameStats; }
+      /**
+       * @brief Gets the render queue flushed after render() every frame.
+       * 
+       * @return A reference to the render queue.
+       */
+      crb::RenderQueue& getRenderQueue()
+      { return this->renderQueue; }
+      /**
+       * @brief Gets the timer measuring the GPU time of the render queue passes.
+       *
+       * Scopes are named after the passes ("Opaque", "Transparent" and "Overlay"), and
+       * "Immediate" covers what render() draws directly.
+       * 
+       * @return A reference to the GPU timer.
+       */
+      const crb::Graphics::GpuTimer& getGpuTimer() const
+      { return *this->gpuTimer; }
+      /**
+       * @brief Gets the number of redundant OpenGL state changes dropped during the last frame.
+       * 
+       * @return The number of OpenGL calls saved by the shadow state.
+       */
+      std::size_t getSavedStateCalls() const
+      { return this->savedStateCalls; }
       /**
        * @brief Gets the currently bound shader.
        * 
@@ -181,6 +271,51 @@ namespace crb
        * @brief Restores the window to its original size after being maximized.
        */
       void unmaximize();
+      /**
+       * @brief Makes the OpenGL context of the window current on the calling thread, along with its shadow state and mesh pool.
+       *
+       * Needed before using the window's OpenGL objects while several windows are alive.
+       * loop() calls it before the first frame.
+       */
+      void makeContextCurrent();
+
+      /**
+       * @brief Starts appending the bound camera of every frame to a path.
+       * 
+       * @param path The path to record into. Must stay alive until the recording is stopped.
+       */
+      void startRecording(crb::CameraPath& path)
+      { this->cameraRecording = &path; }
+      /**
+       * @brief Stops recording the camera.
+       */
+      void stopRecording()
+      { this->cameraRecording = NULL; }
+      /**
+       * @brief Starts driving the bound camera from a recorded path, one frame per frame.
+       * 
+       * Mouse input is ignored and the delta time is the timestep of the path, until
+       * playback is stopped. The camera stays on the last frame once the path ends.
+       * 
+       * @param path The path to play back. Must stay alive until playback is stopped.
+       */
+      void startPlayback(const crb::CameraPath& path)
+      {
+        this->cameraPlayback = &path;
+        this->playbackFrame = 0;
+      }
+      /**
+       * @brief Stops playing back a path, giving the camera back to the inputs.
+       */
+      void stopPlayback()
+      { this->cameraPlayback = NULL; }
+      /**
+       * @brief Checks if a path is being played back.
+       * 
+       * @return True if a path is played back and has frames left, false otherwise.
+       */
+      bool isPlayingBack() const
+      { return this->cameraPlayback != NULL && this->playbackFrame < this->cameraPlayback->getFrameCount(); }
 
       /**
        * @brief Checks if a key is currently pressed.
@@ -229,7 +364,8 @@ namespace crb
       /**
        * @brief Renders the window content.
        *
-       * Override this method to implement custom rendering behavior.
+       * Override this method to implement custom rendering behavior. Items submitted
+       * to the render queue are drawn after this method returns.
        */
       virtual void render()
       {}
@@ -244,14 +380,39 @@ namespace crb
       unsigned int cachedWidth  {800u};
       unsigned int cachedHeight {600u};
 
-      GLFWwindow*      glfwInstance {NULL};
-      crb::Color::RGBA clearColor   {crb::Color::Black};
+      GLFWwindow*       glfwInstance {NULL};
+      crb::Color::RGBA  clearColor   {crb::Color::Black};
+      crb::Window::Mode mode         {crb::Window::Windowed};
+
+      // Headless rendering
+      GLuint      framebuffer  {0u};
+      GLuint      colorBuffer  {0u};
+      GLuint      depthBuffer  {0u};
+      GLsync      frameFences[FRAMES_IN_FLIGHT] {};
+      std::size_t frameIndex   {0u};
+      void*       eglDisplay   {NULL};
+      void*       eglContext   {NULL};
+
+      crb::Graphics::Shader*   boundShader  {NULL};
+      crb::Camera*             boundCamera  {NULL};
+      crb::Graphics::UBO*      cameraBuffer {NULL};
+      crb::Graphics::GpuTimer* gpuTimer     {NULL};
+      crb::FrameCapture*       frameCapture {NULL};
+      crb::RenderQueue         renderQueue;
+      crb::FrameStats          frameStats;
 
-      crb::Graphics::Shader* boundShader {NULL};
-      crb::Camera*           boundCamera {NULL};
+      // Every context has its own bindings, and its meshes are released with it
+      crb::Graphics::State::Cache stateCache;
+      crb::Graphics::MeshPool     meshPool;
 
-      float deltaTime {0.f};
-      float lastTime  {(float)glfwGetTime()};
+      crb::CameraPath*       cameraRecording {NULL};
+      const crb::CameraPath* cameraPlayback  {NULL};
+      std::size_t            playbackFrame   {0u};
+
+      float  deltaTime {0.f};
+      double lastTime  {glfwGetTime()};
+
+      std::size_t savedStateCalls {0u};
 
       bool mouseLocked {false};
       bool maximized   {false};
@@ -260,12 +421,30 @@ namespace crb
        * @brief Internal method for initializing the window.
        */
       void _initialize();
+      /**
+       * @brief Internal method for creating the context of a headless window.
+       *
+       * @return True if a context was created and made current, false otherwise.
+       */
+      bool _createHeadlessContext();
+      /**
+       * @brief Internal method for creating the offscreen framebuffer of a headless window.
+       */
+      void _createFramebuffer();
+      /**
+       * @brief Internal method for ending a headless frame, waiting for the GPU once it falls FRAMES_IN_FLIGHT frames behind.
+       */
+      void _throttle();
+      /**
+       * @brief Internal method for releasing the framebuffer and context of a headless window.
+       */
+      void _releaseHeadless();
       /**
        * @brief Internal method for updating the time difference between frames.
        */
       void _updateDeltaTime();
       /**
-       * @brief Internal method for updating the camera.
+       * @brief Internal method for updating the camera and uploading its data to the camera uniform buffer.
        */
       void _updateCamera();
       /**
@@ -1,6 +1,5 @@
 #version 330 core
 
-in vec3 vertCol;
 in vec2 vertTex;
 
 out vec4 FragColor;
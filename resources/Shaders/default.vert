@@ -1,18 +1,23 @@
 #version 330 core
 
 layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aCol;
-layout (location = 2) in vec2 aTex;
+layout (location = 1) in vec2 aTex;
 
-out vec3 vertCol;
 out vec2 vertTex;
 
+layout (std140) uniform Camera
+{
+  mat4 view;
+  mat4 projection;
+  mat4 viewProjection;
+  mat4 guiProjection;
+  vec4 position;
+} camera;
+
 uniform mat4 model;
-uniform mat4 cameraMatrix;
 
 void main()
 {
-  vertCol = aCol;
   vertTex = aTex;
-  gl_Position = cameraMatrix * model * vec4(aPos, 1.f);
+  gl_Position = camera.viewProjection * model * vec4(aPos, 1.f);
 }
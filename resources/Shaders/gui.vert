@@ -5,11 +5,19 @@ layout (location = 1) in vec2 aTex;
 
 out vec2 vertTex;
 
+layout (std140) uniform Camera
+{
+  mat4 view;
+  mat4 projection;
+  mat4 viewProjection;
+  mat4 guiProjection;
+  vec4 position;
+} camera;
+
 uniform mat4 model;
-uniform mat4 cameraMatrix;
 
 void main()
 {
   vertTex = aTex;
-  gl_Position = cameraMatrix * model * vec4(aPos, 1.f);
+  gl_Position = camera.guiProjection * model * vec4(aPos, 1.f);
 }
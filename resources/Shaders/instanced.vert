@@ -0,0 +1,24 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTex;
+layout (location = 2) in vec3 aOffset;
+
+out vec2 vertTex;
+
+layout (std140) uniform Camera
+{
+  mat4 view;
+  mat4 projection;
+  mat4 viewProjection;
+  mat4 guiProjection;
+  vec4 position;
+} camera;
+
+uniform mat4 model;
+
+void main()
+{
+  vertTex = aTex;
+  gl_Position = camera.viewProjection * model * vec4(aPos + aOffset, 1.f);
+}
@@ -0,0 +1,334 @@
+#include "CRobes/Batch.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#if defined(CRB_SIMD_SSE)
+  #include <immintrin.h>
+#endif
+
+namespace
+{
+#if defined(CRB_SIMD_AVX)
+  using Register = __m256;
+  constexpr std::size_t WIDTH {8u};
+
+  inline Register load(const float* data)                  { return _mm256_loadu_ps(data); }
+  inline void store(float* data, const Register value)     { _mm256_storeu_ps(data, value); }
+  inline Register broadcast(const float value)             { return _mm256_set1_ps(value); }
+  inline Register add(const Register a, const Register b)  { return _mm256_add_ps(a, b); }
+  inline Register sub(const Register a, const Register b)  { return _mm256_sub_ps(a, b); }
+  inline Register mul(const Register a, const Register b)  { return _mm256_mul_ps(a, b); }
+  inline Register div(const Register a, const Register b)  { return _mm256_div_ps(a, b); }
+  inline Register min(const Register a, const Register b)  { return _mm256_min_ps(a, b); }
+  inline Register max(const Register a, const Register b)  { return _mm256_max_ps(a, b); }
+  inline Register sqrt(const Register a)                   { return _mm256_sqrt_ps(a); }
+  inline Register mask(const Register a, const Register b) { return _mm256_and_ps(a, b); }
+  inline Register greater(const Register a, const Register b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+#elif defined(CRB_SIMD_SSE)
+  using Register = __m128;
+  constexpr std::size_t WIDTH {4u};
+
+  inline Register load(const float* data)                  { return _mm_loadu_ps(data); }
+  inline void store(float* data, const Register value)     { _mm_storeu_ps(data, value); }
+  inline Register broadcast(const float value)             { return _mm_set1_ps(value); }
+  inline Register add(const Register a, const Register b)  { return _mm_add_ps(a, b); }
+  inline Register sub(const Register a, const Register b)  { return _mm_sub_ps(a, b); }
+  inline Register mul(const Register a, const Register b)  { return _mm_mul_ps(a, b); }
+  inline Register div(const Register a, const Register b)  { return _mm_div_ps(a, b); }
+  inline Register min(const Register a, const Register b)  { return _mm_min_ps(a, b); }
+  inline Register max(const Register a, const Register b)  { return _mm_max_ps(a, b); }
+  inline Register sqrt(const Register a)                   { return _mm_sqrt_ps(a); }
+  inline Register mask(const Register a, const Register b) { return _mm_and_ps(a, b); }
+  inline Register greater(const Register a, const Register b) { return _mm_cmpgt_ps(a, b); }
+#else
+  constexpr std::size_t WIDTH {1u};
+#endif
+
+  // Number of leading elements handled by the vector loops
+  inline std::size_t vectorizedCount(const std::size_t count)
+  { return count - count % WIDTH; }
+}
+
+void crb::Batch::Vec3Array::resize(const std::size_t size)
+{
+  this->reserve(size);
+  if (size > this->size)
+  {
+    const std::size_t added = size - this->size;
+    std::memset(this->x + this->size, 0, added * sizeof(float));
+    std::memset(this->y + this->size, 0, added * sizeof(float));
+    std::memset(this->z + this->size, 0, added * sizeof(float));
+  }
+  this->size = size;
+}
+
+void crb::Batch::Vec3Array::reserve(const std::size_t capacity)
+{
+  if (capacity <= this->capacity)
+  {
+    return;
+  }
+
+  // One allocation holding the three component arrays back to back
+  const std::size_t stride = (capacity * sizeof(float) + crb::Batch::ALIGNMENT - 1) / crb::Batch::ALIGNMENT * crb::Batch::ALIGNMENT;
+  float* storage = (float*)::operator new(stride * 3, std::align_val_t(crb::Batch::ALIGNMENT));
+  float* newX = storage;
+  float* newY = (float*)((char*)storage + stride);
+  float* newZ = (float*)((char*)storage + stride * 2);
+
+  if (this->size > 0)
+  {
+    std::memcpy(newX, this->x, this->size * sizeof(float));
+    std::memcpy(newY, this->y, this->size * sizeof(float));
+    std::memcpy(newZ, this->z, this->size * sizeof(float));
+  }
+  this->_release();
+
+  this->x = newX;
+  this->y = newY;
+  this->z = newZ;
+  this->capacity = capacity;
+}
+
+void crb::Batch::Vec3Array::_release()
+{
+  if (this->x != NULL)
+  {
+    ::operator delete(this->x, std::align_val_t(crb::Batch::ALIGNMENT));
+  }
+  this->x = NULL;
+  this->y = NULL;
+  this->z = NULL;
+  this->capacity = 0;
+}
+
+void crb::Batch::Vec3Array::_take(crb::Batch::Vec3Array& other)
+{
+  this->x = other.x;
+  this->y = other.y;
+  this->z = other.z;
+  this->size = other.size;
+  this->capacity = other.capacity;
+
+  other.x = NULL;
+  other.y = NULL;
+  other.z = NULL;
+  other.size = 0;
+  other.capacity = 0;
+}
+
+void crb::Batch::transform(const crb::Space::Mat4& mat, const crb::Batch::Vec3Array& input, crb::Batch::Vec3Array& output, const float w)
+{
+  const std::size_t count = input.getSize();
+  output.resize(count);
+
+  const float* inX = input.getX();
+  const float* inY = input.getY();
+  const float* inZ = input.getZ();
+  float* outX = output.getX();
+  float* outY = output.getY();
+  float* outZ = output.getZ();
+
+  std::size_t i {0u};
+#if defined(CRB_SIMD_SSE)
+  const Register m00 = broadcast(mat[0][0]), m01 = broadcast(mat[0][1]), m02 = broadcast(mat[0][2]);
+  const Register m10 = broadcast(mat[1][0]), m11 = broadcast(mat[1][1]), m12 = broadcast(mat[1][2]);
+  const Register m20 = broadcast(mat[2][0]), m21 = broadcast(mat[2][1]), m22 = broadcast(mat[2][2]);
+  const Register t0 = broadcast(mat[3][0] * w), t1 = broadcast(mat[3][1] * w), t2 = broadcast(mat[3][2] * w);
+
+  for (; i < vectorizedCount(count); i += WIDTH)
+  {
+    const Register x = load(inX + i);
+    const Register y = load(inY + i);
+    const Register z = load(inZ + i);
+    store(outX + i, add(add(mul(x, m00), mul(y, m10)), add(mul(z, m20), t0)));
+    store(outY + i, add(add(mul(x, m01), mul(y, m11)), add(mul(z, m21), t1)));
+    store(outZ + i, add(add(mul(x, m02), mul(y, m12)), add(mul(z, m22), t2)));
+  }
+#endif
+  for (; i < count; i++)
+  {
+    const float x = inX[i];
+    const float y = inY[i];
+    const float z = inZ[i];
+    outX[i] = x * mat[0][0] + y * mat[1][0] + z * mat[2][0] + w * mat[3][0];
+    outY[i] = x * mat[0][1] + y * mat[1][1] + z * mat[2][1] + w * mat[3][1];
+    outZ[i] = x * mat[0][2] + y * mat[1][2] + z * mat[2][2] + w * mat[3][2];
+  }
+}
+
+void crb::Batch::dot(const crb::Batch::Vec3Array& inputOne, const crb::Batch::Vec3Array& inputTwo, float* output)
+{
+  const std::size_t count = inputOne.getSize();
+  const float* aX = inputOne.getX();
+  const float* aY = inputOne.getY();
+  const float* aZ = inputOne.getZ();
+  const float* bX = inputTwo.getX();
+  const float* bY = inputTwo.getY();
+  const float* bZ = inputTwo.getZ();
+
+  std::size_t i {0u};
+#if defined(CRB_SIMD_SSE)
+  for (; i < vectorizedCount(count); i += WIDTH)
+  {
+    store(output + i, add(add(mul(load(aX + i), load(bX + i)), mul(load(aY + i), load(bY + i))), mul(load(aZ + i), load(bZ + i))));
+  }
+#endif
+  for (; i < count; i++)
+  {
+    output[i] = aX[i] * bX[i] + aY[i] * bY[i] + aZ[i] * bZ[i];
+  }
+}
+
+void crb::Batch::cross(const crb::Batch::Vec3Array& inputOne, const crb::Batch::Vec3Array& inputTwo, crb::Batch::Vec3Array& output)
+{
+  const std::size_t count = inputOne.getSize();
+  output.resize(count);
+
+  const float* aX = inputOne.getX();
+  const float* aY = inputOne.getY();
+  const float* aZ = inputOne.getZ();
+  const float* bX = inputTwo.getX();
+  const float* bY = inputTwo.getY();
+  const float* bZ = inputTwo.getZ();
+  float* outX = output.getX();
+  float* outY = output.getY();
+  float* outZ = output.getZ();
+
+  std::size_t i {0u};
+#if defined(CRB_SIMD_SSE)
+  for (; i < vectorizedCount(count); i += WIDTH)
+  {
+    const Register ax = load(aX + i), ay = load(aY + i), az = load(aZ + i);
+    const Register bx = load(bX + i), by = load(bY + i), bz = load(bZ + i);
+    store(outX + i, sub(mul(ay, bz), mul(az, by)));
+    store(outY + i, sub(mul(az, bx), mul(ax, bz)));
+    store(outZ + i, sub(mul(ax, by), mul(ay, bx)));
+  }
+#endif
+  for (; i < count; i++)
+  {
+    const float ax = aX[i], ay = aY[i], az = aZ[i];
+    const float bx = bX[i], by = bY[i], bz = bZ[i];
+    outX[i] = ay * bz - az * by;
+    outY[i] = az * bx - ax * bz;
+    outZ[i] = ax * by - ay * bx;
+  }
+}
+
+void crb::Batch::lengthOf(const crb::Batch::Vec3Array& input, float* output)
+{
+  const std::size_t count = input.getSize();
+  const float* inX = input.getX();
+  const float* inY = input.getY();
+  const float* inZ = input.getZ();
+
+  std::size_t i {0u};
+#if defined(CRB_SIMD_SSE)
+  for (; i < vectorizedCount(count); i += WIDTH)
+  {
+    const Register x = load(inX + i), y = load(inY + i), z = load(inZ + i);
+    store(output + i, sqrt(add(add(mul(x, x), mul(y, y)), mul(z, z))));
+  }
+#endif
+  for (; i < count; i++)
+  {
+    output[i] = sqrtf(inX[i] * inX[i] + inY[i] * inY[i] + inZ[i] * inZ[i]);
+  }
+}
+
+void crb::Batch::normalize(const crb::Batch::Vec3Array& input, crb::Batch::Vec3Array& output)
+{
+  const std::size_t count = input.getSize();
+  output.resize(count);
+
+  const float* inX = input.getX();
+  const float* inY = input.getY();
+  const float* inZ = input.getZ();
+  float* outX = output.getX();
+  float* outY = output.getY();
+  float* outZ = output.getZ();
+
+  std::size_t i {0u};
+#if defined(CRB_SIMD_SSE)
+  const Register zero = broadcast(0.f);
+  const Register one = broadcast(1.f);
+  for (; i < vectorizedCount(count); i += WIDTH)
+  {
+    const Register x = load(inX + i), y = load(inY + i), z = load(inZ + i);
+    const Register length = sqrt(add(add(mul(x, x), mul(y, y)), mul(z, z)));
+    // Zero-length vectors get a zero scale instead of a division by zero
+    const Register scale = mask(div(one, length), greater(length, zero));
+    store(outX + i, mul(x, scale));
+    store(outY + i, mul(y, scale));
+    store(outZ + i, mul(z, scale));
+  }
+#endif
+  for (; i < count; i++)
+  {
+    const float length = sqrtf(inX[i] * inX[i] + inY[i] * inY[i] + inZ[i] * inZ[i]);
+    const float scale = length > 0.f ? 1.f / length : 0.f;
+    outX[i] = inX[i] * scale;
+    outY[i] = inY[i] * scale;
+    outZ[i] = inZ[i] * scale;
+  }
+}
+
+void crb::Batch::bounds(const crb::Batch::Vec3Array& input, crb::Space::Vec3& oMin, crb::Space::Vec3& oMax)
+{
+  const std::size_t count = input.getSize();
+  const float* inX = input.getX();
+  const float* inY = input.getY();
+  const float* inZ = input.getZ();
+
+  oMin = input.get(0);
+  oMax = input.get(0);
+
+  std::size_t i {0u};
+#if defined(CRB_SIMD_SSE)
+  if (count >= WIDTH)
+  {
+    Register minX = load(inX), minY = load(inY), minZ = load(inZ);
+    Register maxX = minX, maxY = minY, maxZ = minZ;
+    for (i = WIDTH; i < vectorizedCount(count); i += WIDTH)
+    {
+      const Register x = load(inX + i), y = load(inY + i), z = load(inZ + i);
+      minX = min(minX, x);
+      minY = min(minY, y);
+      minZ = min(minZ, z);
+      maxX = max(maxX, x);
+      maxY = max(maxY, y);
+      maxZ = max(maxZ, z);
+    }
+
+    // Reducing the lanes
+    alignas(crb::Batch::ALIGNMENT) float lanes[6][WIDTH];
+    store(lanes[0], minX);
+    store(lanes[1], minY);
+    store(lanes[2], minZ);
+    store(lanes[3], maxX);
+    store(lanes[4], maxY);
+    store(lanes[5], maxZ);
+    for (std::size_t lane = 0; lane < WIDTH; lane++)
+    {
+      oMin.x = std::min(oMin.x, lanes[0][lane]);
+      oMin.y = std::min(oMin.y, lanes[1][lane]);
+      oMin.z = std::min(oMin.z, lanes[2][lane]);
+      oMax.x = std::max(oMax.x, lanes[3][lane]);
+      oMax.y = std::max(oMax.y, lanes[4][lane]);
+      oMax.z = std::max(oMax.z, lanes[5][lane]);
+    }
+  }
+#endif
+  for (; i < count; i++)
+  {
+    oMin.x = std::min(oMin.x, inX[i]);
+    oMin.y = std::min(oMin.y, inY[i]);
+    oMin.z = std::min(oMin.z, inZ[i]);
+    oMax.x = std::max(oMax.x, inX[i]);
+    oMax.y = std::max(oMax.y, inY[i]);
+    oMax.z = std::max(oMax.z, inZ[i]);
+  }
+}
@@ -0,0 +1,184 @@
+#include "CRobes/BufferArena.hpp"
+
+#include <iostream>
+#include <iterator>
+
+bool crb::Graphics::OffsetAllocator::allocate(const GLuint size, GLuint& oOffset)
+{
+  if (size == 0 || size > this->freeSize)
+  {
+    return false;
+  }
+
+  // Best fit keeps the large ranges available for large meshes
+  auto best = this->ranges.end();
+  for (auto range = this->ranges.begin(); range != this->ranges.end(); range++)
+  {
+    if (range->second >= size && (best == this->ranges.end() || range->second < best->second))
+    {
+      best = range;
+      if (range->second == size)
+      {
+        break;
+      }
+    }
+  }
+  if (best == this->ranges.end())
+  {
+    return false;
+  }
+
+  oOffset = best->first;
+  const GLuint remaining = best->second - size;
+  this->ranges.erase(best);
+  if (remaining > 0)
+  {
+    this->ranges.emplace(oOffset + size, remaining);
+  }
+  this->freeSize -= size;
+  return true;
+}
+
+void crb::Graphics::OffsetAllocator::free(const GLuint offset, const GLuint size)
+{
+  if (size == 0)
+  {
+    return;
+  }
+
+  auto next = this->ranges.lower_bound(offset);
+  GLuint start = offset;
+  GLuint end = offset + size;
+
+  // Merging with the free range right before
+  if (next != this->ranges.begin())
+  {
+    auto previous = std::prev(next);
+    if (previous->first + previous->second == start)
+    {
+      start = previous->first;
+      this->ranges.erase(previous);
+    }
+  }
+  // Merging with the free range right after
+  if (next != this->ranges.end() && next->first == end)
+  {
+    end += next->second;
+    this->ranges.erase(next);
+  }
+
+  this->ranges.emplace(start, end - start);
+  this->freeSize += size;
+}
+
+crb::Graphics::BufferArena::Page::Page(const crb::Graphics::VertexLayout& layout, const GLuint vertexCount, const GLuint indexCount)
+: mesh(crb::Graphics::createMesh(layout, (GLsizeiptr)vertexCount * layout.getStride(), (GLsizeiptr)indexCount * sizeof(GLuint), GL_DYNAMIC_DRAW)),
+  vertices(vertexCount),
+  indices(indexCount)
+{}
+
+crb::Graphics::BufferArena::~BufferArena()
+{
+  for (std::unique_ptr<Page>& page : this->pages)
+  {
+    crb::Graphics::destroyMesh(page->mesh);
+  }
+}
+
+bool crb::Graphics::BufferArena::allocate(const void* vertices, GLsizeiptr verticesSize, const GLuint indices[], GLsizeiptr indicesSize, crb::Graphics::BufferArena::Allocation& oAllocation)
+{
+  const GLuint vertexCount = verticesSize / this->layout.getStride();
+  const GLuint indexCount = indicesSize / sizeof(GLuint);
+  if (vertexCount > this->pageVertexCount || indexCount > this->pageIndexCount)
+  {
+    std::cerr << "Mesh with " << vertexCount << " vertices and " << indexCount << " indices does not fit in a buffer arena page!\n";
+    return false;
+  }
+
+  std::size_t pageIndex {0u};
+  for (; pageIndex <= this->pages.size(); pageIndex++)
+  {
+    if (pageIndex == this->pages.size())
+    {
+      this->pages.push_back(std::make_unique<Page>(this->layout, this->pageVertexCount, this->pageIndexCount));
+    }
+    Page& page = *this->pages[pageIndex];
+    if (!page.vertices.allocate(vertexCount, oAllocation.firstVertex))
+    {
+      continue;
+    }
+    if (!page.indices.allocate(indexCount, oAllocation.firstIndex))
+    {
+      page.vertices.free(oAllocation.firstVertex, vertexCount);
+      continue;
+    }
+    break;
+  }
+  oAllocation.page = pageIndex;
+  oAllocation.vertexCount = vertexCount;
+  oAllocation.indexCount = indexCount;
+
+  const crb::Graphics::MeshBuffers* buffers = crb::Graphics::getMesh(this->pages[pageIndex]->mesh);
+  if (buffers == NULL)
+  {
+    this->free(oAllocation);
+    return false;
+  }
+  crb::Graphics::State::bindVertexArray(buffers->vertexArray);
+  crb::Graphics::State::bindBuffer(GL_ARRAY_BUFFER, buffers->vertexBuffer);
+  glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)oAllocation.firstVertex * this->layout.getStride(), verticesSize, vertices);
+  glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)oAllocation.firstIndex * sizeof(GLuint), indicesSize, indices);
+  crb::Graphics::State::bindVertexArray(0);
+  crb::Graphics::State::bindBuffer(GL_ARRAY_BUFFER, 0);
+  return true;
+}
+
+void crb::Graphics::BufferArena::free(const crb::Graphics::BufferArena::Allocation& allocation)
+{
+  if (allocation.page >= this->pages.size())
+  {
+    return;
+  }
+  Page& page = *this->pages[allocation.page];
+  page.vertices.free(allocation.firstVertex, allocation.vertexCount);
+  page.indices.free(allocation.firstIndex, allocation.indexCount);
+}
+
+std::size_t crb::Graphics::BufferArena::render(GLenum mode, const std::vector<const crb::Graphics::BufferArena::Allocation*>& allocations) const
+{
+  for (const crb::Graphics::BufferArena::Allocation* allocation : allocations)
+  {
+    Page& page = *this->pages[allocation->page];
+    page.counts.push_back((GLsizei)allocation->indexCount);
+    page.offsets.push_back((void*)((std::size_t)allocation->firstIndex * sizeof(GLuint)));
+    page.baseVertices.push_back((GLint)allocation->firstVertex);
+  }
+
+  std::size_t drawCalls {0u};
+  for (const std::unique_ptr<Page>& page : this->pages)
+  {
+    const crb::Graphics::MeshBuffers* buffers = crb::Graphics::getMesh(page->mesh);
+    if (page->counts.empty() || buffers == NULL)
+    {
+      page->counts.clear();
+      page->offsets.clear();
+      page->baseVertices.clear();
+      continue;
+    }
+    crb::Graphics::State::bindVertexArray(buffers->vertexArray);
+    glMultiDrawElementsBaseVertex(
+      mode,
+      page->counts.data(),
+      GL_UNSIGNED_INT,
+      page->offsets.data(),
+      (GLsizei)page->counts.size(),
+      page->baseVertices.data()
+    );
+    drawCalls++;
+
+    page->counts.clear();
+    page->offsets.clear();
+    page->baseVertices.clear();
+  }
+  return drawCalls;
+}
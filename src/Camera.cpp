@@ -1,5 +1,7 @@
 #include "CRobes/Camera.hpp"
 
+static_assert(sizeof(crb::Camera::Block) == 4 * 64 + 16, "Camera::Block must match the std140 layout of the Camera uniform block");
+
 void crb::Camera::updatePosition(const float deltaTime)
 {
   const float usedSpeed = this->speed * deltaTime;
@@ -48,31 +50,28 @@ void crb::Camera::updateMatrix()
     sinYaw,
   };
 
-  crb::Space::Mat4 view {1.f};
-  crb::Space::Mat4 projection {1.f};
-  
-  if (this->using3D)
-  {
-    view = crb::Space::lookAt(
-      this->position,
-      this->position + tempFront,
-      this->up
-    );
-  }
-  projection = this->using3D
-    ? crb::Space::perspective(
-      this->fov,
-      (float)this->bufferWidth / this->bufferHeight,
-      this->zNear,
-      this->zFar
-    ) : crb::Space::ortho(
-      0,
-      this->bufferWidth,
-      0,
-      this->bufferHeight,
-      -1.f,
-      1.f
-    );
+  this->block.view = crb::Space::lookAt(
+    this->position,
+    this->position + tempFront,
+    this->up
+  );
+  this->block.projection = crb::Space::perspective(
+    this->fov,
+    (float)this->bufferWidth / this->bufferHeight,
+    this->zNear,
+    this->zFar
+  );
+  this->block.viewProjection = this->block.view * this->block.projection;
+  this->block.guiProjection = crb::Space::ortho(
+    0,
+    this->bufferWidth,
+    0,
+    this->bufferHeight,
+    -1.f,
+    1.f
+  );
+  this->block.position = {this->position, 1.f};
 
-  this->matrix = view * projection;
+  this->matrix = this->using3D ? this->block.viewProjection : this->block.guiProjection;
+  this->frustum = crb::Space::extractFrustum(this->block.viewProjection);
 }
@@ -0,0 +1,103 @@
+#include "CRobes/CameraPath.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+  // Written before the frames, which follow as FRAME_FLOATS floats each
+  struct PathHeader
+  {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t frameCount;
+    float         timestep;
+  };
+
+  constexpr std::uint32_t PATH_MAGIC   {0x50435243u};
+  constexpr std::uint32_t PATH_VERSION {1u};
+  constexpr std::size_t   FRAME_FLOATS {6u};
+}
+
+void crb::CameraPath::record(const crb::Camera& camera)
+{
+  crb::CameraPath::Frame frame;
+  frame.position = camera.getPosition();
+  frame.yaw = camera.getYaw();
+  frame.pitch = camera.getPitch();
+  frame.fov = camera.getFov();
+  this->frames.push_back(frame);
+}
+
+void crb::CameraPath::apply(const std::size_t index, crb::Camera& camera) const
+{
+  const crb::CameraPath::Frame& frame = this->frames[index];
+  camera.setPosition(frame.position);
+  camera.setRotation(frame.yaw, frame.pitch);
+  camera.setFov(frame.fov);
+}
+
+bool crb::CameraPath::save(const std::string& path) const
+{
+  const PathHeader header {PATH_MAGIC, PATH_VERSION, (std::uint32_t)this->frames.size(), this->timestep};
+
+  std::vector<char> data(sizeof(PathHeader) + this->frames.size() * FRAME_FLOATS * sizeof(float));
+  std::memcpy(data.data(), &header, sizeof(PathHeader));
+  float* values = (float*)(data.data() + sizeof(PathHeader));
+  for (const crb::CameraPath::Frame& frame : this->frames)
+  {
+    const float frameValues[FRAME_FLOATS] {
+      frame.position.x, frame.position.y, frame.position.z,
+      frame.yaw, frame.pitch, frame.fov
+    };
+    std::memcpy(values, frameValues, sizeof(frameValues));
+    values += FRAME_FLOATS;
+  }
+
+  if (!crb::File::setBinaryContents(path, data.data(), data.size()))
+  {
+    std::cerr << "Failed to write the camera path (" << path << ")!\n";
+    return false;
+  }
+  return true;
+}
+
+bool crb::CameraPath::load(const std::string& path)
+{
+  std::vector<char> data;
+  if (!crb::File::getBinaryContents(path, data))
+  {
+    std::cerr << "Failed to read the camera path (" << path << ")!\n";
+    return false;
+  }
+
+  PathHeader header;
+  if (data.size() < sizeof(PathHeader))
+  {
+    std::cerr << "Invalid camera path (" << path << ")!\n";
+    return false;
+  }
+  std::memcpy(&header, data.data(), sizeof(PathHeader));
+  if (header.magic != PATH_MAGIC || header.version != PATH_VERSION || data.size() != sizeof(PathHeader) + header.frameCount * FRAME_FLOATS * sizeof(float))
+  {
+    std::cerr << "Invalid camera path (" << path << ")!\n";
+    return false;
+  }
+
+  this->timestep = header.timestep;
+  this->frames.resize(header.frameCount);
+  const char* values = data.data() + sizeof(PathHeader);
+  for (crb::CameraPath::Frame& frame : this->frames)
+  {
+    float frameValues[FRAME_FLOATS];
+    std::memcpy(frameValues, values, sizeof(frameValues));
+    values += sizeof(frameValues);
+
+    frame.position = {frameValues[0], frameValues[1], frameValues[2]};
+    frame.yaw = frameValues[3];
+    frame.pitch = frameValues[4];
+    frame.fov = frameValues[5];
+  }
+  return true;
+}
@@ -0,0 +1,394 @@
+#include "CRobes/ChunkManager.hpp"
+#include "CRobes/MeshBuilder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <cstdlib>
+
+namespace
+{
+  // Calls the callback for every chunk of the square around `from` that is not part of the square around `to`
+  template <typename Callback>
+  void forEachDifference(const crb::ChunkManager::Key& from, const crb::ChunkManager::Key& to, const int radius, const Callback& callback)
+  {
+    for (int z = from.second - radius; z <= from.second + radius; z++)
+    {
+      if (std::abs(z - to.second) > radius)
+      {
+        for (int x = from.first - radius; x <= from.first + radius; x++)
+        {
+          callback(crb::ChunkManager::Key {x, z});
+        }
+        continue;
+      }
+      // Only the columns left and right of the destination square
+      for (int x = from.first - radius; x <= std::min(from.first + radius, to.first - radius - 1); x++)
+      {
+        callback(crb::ChunkManager::Key {x, z});
+      }
+      for (int x = std::max(from.first - radius, to.first + radius + 1); x <= from.first + radius; x++)
+      {
+        callback(crb::ChunkManager::Key {x, z});
+      }
+    }
+  }
+}
+
+bool crb::ChunkManager::update(const crb::Space::Vec3& cameraPosition)
+{
+  CRB_PROFILE_SCOPE("ChunkManager::update");
+  this->deletionQueue.collect();
+
+  const crb::ChunkManager::Key center {
+    crb::Space::getChunkX(cameraPosition),
+    crb::Space::getChunkZ(cameraPosition)
+  };
+  if (this->initialized && center == this->center)
+  {
+    return this->blocking ? this->_drain() : this->_upload();
+  }
+
+  const int radius = (int)this->renderDistance - 1;
+
+  if (!this->initialized)
+  {
+    for (int z = center.second - radius; z <= center.second + radius; z++)
+    {
+      for (int x = center.first - radius; x <= center.first + radius; x++)
+      {
+        this->_request({x, z});
+      }
+    }
+  }
+  else
+  {
+    // Evicting the chunks that left the square
+    forEachDifference(this->center, center, radius, [&](const crb::ChunkManager::Key& key)
+    {
+      this->chunks.erase(key);
+      this->pending.erase(key);
+      this->instances.erase(key);
+      this->_evictArenaChunk(key);
+    });
+
+    // Requesting the chunks that entered the square
+    forEachDifference(center, this->center, radius, [&](const crb::ChunkManager::Key& key)
+    {
+      this->_request(key);
+    });
+  }
+
+  this->center = center;
+  this->initialized = true;
+  if (this->blocking)
+  {
+    this->_drain();
+  }
+  else
+  {
+    this->_upload();
+  }
+  return true;
+}
+
+std::size_t crb::ChunkManager::cull(const crb::Space::Frustum& frustum, std::vector<const crb::Solids::Solid*>& oVisible) const
+{
+  oVisible.clear();
+  for (const auto& [key, chunk] : this->chunks)
+  {
+    if (chunk.isVisible(frustum))
+    {
+      oVisible.push_back(&chunk);
+    }
+  }
+  return this->chunks.size() - oVisible.size();
+}
+
+std::size_t crb::ChunkManager::render(const crb::Graphics::Shader& shader, GLenum mode, const crb::Space::Frustum& frustum)
+{
+  const std::size_t culled = this->_collect(frustum);
+  if (this->storage == crb::ChunkManager::Solids)
+  {
+    for (const crb::Solids::Solid* chunk : this->visibleChunks)
+    {
+      chunk->render(shader, mode);
+    }
+  }
+  else if (this->storage == crb::ChunkManager::Arena)
+  {
+    crb::ChunkManager::_drawArena(this, shader, mode);
+  }
+  else if (this->sharedMesh != nullptr)
+  {
+    this->sharedMesh->render(shader, mode);
+  }
+  return culled;
+}
+
+std::size_t crb::ChunkManager::submit(crb::RenderQueue& queue, const crb::Graphics::Shader& shader, const crb::Graphics::Texture* texture, GLenum mode, const crb::Space::Frustum& frustum)
+{
+  const std::size_t culled = this->_collect(frustum);
+  if (this->storage == crb::ChunkManager::Solids)
+  {
+    for (const crb::Solids::Solid* chunk : this->visibleChunks)
+    {
+      queue.submit(*chunk, shader, texture, mode);
+    }
+    return culled;
+  }
+
+  // A single item draws every visible chunk
+  crb::RenderQueue::Item item;
+  item.shader = &shader;
+  item.texture = texture;
+  item.mode = mode;
+  if (this->storage == crb::ChunkManager::Arena)
+  {
+    item.object = this;
+    item.draw = crb::ChunkManager::_drawArena;
+  }
+  else if (this->sharedMesh != nullptr)
+  {
+    item.object = this->sharedMesh.get();
+    item.draw = [](const void* object, const crb::Graphics::Shader& shader, GLenum mode)
+    {
+      ((const crb::Solids::InstancedSolid*)object)->render(shader, mode);
+    };
+    item.vertexArray = this->sharedMesh->getVertexArrayID();
+  }
+  if (item.draw != NULL)
+  {
+    queue.submit(item);
+  }
+  return culled;
+}
+
+std::size_t crb::ChunkManager::_collect(const crb::Space::Frustum& frustum)
+{
+  if (this->storage == crb::ChunkManager::Solids)
+  {
+    return this->cull(frustum, this->visibleChunks);
+  }
+
+  if (this->storage == crb::ChunkManager::Arena)
+  {
+    this->visibleAllocations.clear();
+    for (const auto& [key, chunk] : this->arenaChunks)
+    {
+      if (frustum.intersects(chunk.bounds))
+      {
+        this->visibleAllocations.push_back(&chunk.allocation);
+      }
+    }
+    return this->arenaChunks.size() - this->visibleAllocations.size();
+  }
+
+  if (this->sharedMesh == nullptr)
+  {
+    return 0;
+  }
+
+  const crb::Space::AABB& bounds = this->sharedMesh->getBounds();
+  this->visibleOffsets.clear();
+  for (const crb::ChunkManager::Key& key : this->instances)
+  {
+    const crb::Space::Vec3 offset {key.first * crb::CHUNK_SIZE, 0.f, key.second * crb::CHUNK_SIZE};
+    if (frustum.intersects({bounds.min + offset, bounds.max + offset}))
+    {
+      this->visibleOffsets.push_back(offset);
+    }
+  }
+  this->sharedMesh->setInstances(this->visibleOffsets);
+  return this->instances.size() - this->visibleOffsets.size();
+}
+
+void crb::ChunkManager::_drawArena(const void* object, const crb::Graphics::Shader& shader, GLenum mode)
+{
+  const crb::ChunkManager* chunkManager = (const crb::ChunkManager*)object;
+
+  // Vertices are already in world space
+  shader.SetMatrix4(crb::Space::Mat4(1.f), "model");
+  chunkManager->arena.render(mode, chunkManager->visibleAllocations);
+}
+
+void crb::ChunkManager::_request(const crb::ChunkManager::Key& key)
+{
+  if (this->storage == crb::ChunkManager::Instances)
+  {
+    // All chunks share the same geometry, which is generated once
+    if (this->sharedMesh == nullptr)
+    {
+      this->sharedMesh = std::make_unique<crb::Solids::InstancedSolid>(crb::Solids::SolidFactory().generatePlane(
+        crb::CHUNK_SIZE,
+        crb::CHUNK_SIZE,
+        crb::CHUNK_SEGMENTS
+      ));
+    }
+    this->instances.insert(key);
+    return;
+  }
+
+  if (this->hasChunk(key) || !this->pending.insert(key).second)
+  {
+    return;
+  }
+
+  const bool bakePosition = this->storage == crb::ChunkManager::Arena;
+  if (!bakePosition)
+  {
+    // The chunks only differ in position, so they share the cached mesh, generated once on a miss
+    const crb::Solids::MeshCache::Key planeKey = crb::Solids::MeshCache::getPlaneKey(crb::CHUNK_SIZE, crb::CHUNK_SIZE, crb::CHUNK_SEGMENTS);
+    if (this->meshCache.isCached(planeKey))
+    {
+      std::optional<crb::Solids::Solid> chunk = this->meshCache.create({key.first * crb::CHUNK_SIZE, 0.f, key.second * crb::CHUNK_SIZE}, planeKey);
+      if (chunk.has_value())
+      {
+        this->pending.erase(key);
+        this->chunks.emplace(key, std::move(*chunk));
+        return;
+      }
+    }
+    if (this->planeRequested)
+    {
+      return;
+    }
+    this->planeRequested = true;
+  }
+
+  std::shared_ptr<crb::ChunkManager::Inbox> inbox = this->inbox;
+  this->threadPool.submit([inbox, key, bakePosition]()
+  {
+    CRB_PROFILE_SCOPE("ChunkManager::generate");
+    crb::Solids::Mesh mesh = crb::Solids::SolidFactory().generatePlane(
+      crb::CHUNK_SIZE,
+      crb::CHUNK_SIZE,
+      crb::CHUNK_SEGMENTS
+    );
+    if (bakePosition)
+    {
+      crb::Solids::translate(mesh, {key.first * crb::CHUNK_SIZE, 0.f, key.second * crb::CHUNK_SIZE});
+    }
+
+    {
+      std::lock_guard<std::mutex> lock {inbox->mutex};
+      inbox->meshes.emplace_back(key, std::move(mesh));
+    }
+    inbox->delivered.notify_one();
+  });
+}
+
+bool crb::ChunkManager::_upload()
+{
+  {
+    std::lock_guard<std::mutex> lock {this->inbox->mutex};
+    if (this->inbox->meshes.empty() && this->finished.empty())
+    {
+      return false;
+    }
+    std::move(this->inbox->meshes.begin(), this->inbox->meshes.end(), std::back_inserter(this->finished));
+    this->inbox->meshes.clear();
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto budget = std::chrono::duration<float, std::milli>(this->uploadBudget);
+
+  bool uploaded {false};
+  std::size_t consumed {0u};
+  while (consumed < this->finished.size())
+  {
+    auto& [key, mesh] = this->finished[consumed++];
+    if (this->storage == crb::ChunkManager::Solids)
+    {
+      uploaded = this->_uploadPlane(mesh) || uploaded;
+      crb::Solids::MeshBuilder::recycle(std::move(mesh));
+      continue;
+    }
+
+    // Chunks evicted while their mesh was generated are dropped
+    if (this->pending.erase(key) == 0)
+    {
+      crb::Solids::MeshBuilder::recycle(std::move(mesh));
+      continue;
+    }
+    crb::ChunkManager::ArenaChunk chunk;
+    chunk.bounds = crb::Solids::computeBounds(mesh.vertices.data(), mesh.vertices.size());
+    if (this->arena.allocate(
+      mesh.vertices.data(),
+      (GLsizeiptr)(mesh.vertices.size() * sizeof(GLfloat)),
+      mesh.indices.data(),
+      (GLsizeiptr)(mesh.indices.size() * sizeof(GLuint)),
+      chunk.allocation
+    ))
+    {
+      this->arenaChunks.emplace(key, chunk);
+    }
+    crb::Solids::MeshBuilder::recycle(std::move(mesh));
+    uploaded = true;
+
+    if (!this->blocking && std::chrono::steady_clock::now() - start >= budget)
+    {
+      break;
+    }
+  }
+  this->finished.erase(this->finished.begin(), this->finished.begin() + consumed);
+  return uploaded;
+}
+
+bool crb::ChunkManager::_drain()
+{
+  bool uploaded = this->_upload();
+  while (!this->pending.empty())
+  {
+    {
+      std::unique_lock<std::mutex> lock {this->inbox->mutex};
+      this->inbox->delivered.wait(lock, [this]() { return !this->inbox->meshes.empty(); });
+    }
+    uploaded = this->_upload() || uploaded;
+  }
+  return uploaded;
+}
+
+bool crb::ChunkManager::_uploadPlane(const crb::Solids::Mesh& mesh)
+{
+  this->planeRequested = false;
+
+  // Every pending chunk was waiting for this mesh, and none is left if they were all evicted
+  if (this->pending.empty())
+  {
+    return false;
+  }
+  const crb::Solids::MeshCache::Key planeKey = crb::Solids::MeshCache::getPlaneKey(crb::CHUNK_SIZE, crb::CHUNK_SIZE, crb::CHUNK_SEGMENTS);
+  this->meshCache.upload(planeKey, mesh);
+  bool created = false;
+  for (auto key = this->pending.begin(); key != this->pending.end();)
+  {
+    std::optional<crb::Solids::Solid> chunk = this->meshCache.create({key->first * crb::CHUNK_SIZE, 0.f, key->second * crb::CHUNK_SIZE}, planeKey);
+    if (!chunk.has_value())
+    {
+      break;
+    }
+    this->chunks.emplace(*key, std::move(*chunk));
+    key = this->pending.erase(key);
+    created = true;
+  }
+  // Chunks left without a mesh stop waiting, and are requested again when they re-enter the resident square
+  this->pending.clear();
+  return created;
+}
+
+void crb::ChunkManager::_evictArenaChunk(const crb::ChunkManager::Key& key)
+{
+  auto chunk = this->arenaChunks.find(key);
+  if (chunk == this->arenaChunks.end())
+  {
+    return;
+  }
+  // The space is only reused once the frames drawing the chunk are finished
+  const crb::Graphics::BufferArena::Allocation allocation = chunk->second.allocation;
+  this->deletionQueue.defer([this, allocation]()
+  {
+    this->arena.free(allocation);
+  });
+  this->arenaChunks.erase(chunk);
+}
@@ -14,8 +14,12 @@ void crb::Core::printVersionInfo()
   std::cout << "GLFW:   " << glfwGetVersionString() << '\n';
 }
 
-void crb::Core::initializeGlfw()
+void crb::Core::initializeGlfw(const bool headless)
 {
+  if (headless)
+  {
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+  }
   GLenum glfwInitializationState = glfwInit();
   if (!glfwInitializationState)
   {
@@ -30,7 +34,7 @@ void crb::Core::initializeGlfw()
 void crb::Core::initializeGlew()
 {
   GLenum glewInitializationState = glewInit();
-  if (glewInitializationState != GLEW_OK)
+  if (glewInitializationState != GLEW_OK && glewInitializationState != GLEW_ERROR_NO_GLX_DISPLAY)
   {
     std::cerr << "Failed to initialize GLEW!\n";
     std::cerr << "Error: " << glewGetErrorString(glewInitializationState) << '\n';
@@ -0,0 +1,159 @@
+#include "CRobes/DeletionQueue.hpp"
+
+crb::Graphics::MeshBuffers crb::Graphics::createMeshBuffers(const crb::Graphics::VertexLayout& layout, const GLsizeiptr verticesSize, const GLsizeiptr indicesSize, const GLenum usage)
+{
+  crb::Graphics::MeshBuffers buffers;
+  buffers.verticesSize = verticesSize;
+  buffers.indicesSize = indicesSize;
+  buffers.layout = &layout;
+
+  glGenVertexArrays(1, &buffers.vertexArray);
+  glGenBuffers(1, &buffers.vertexBuffer);
+  glGenBuffers(1, &buffers.indexBuffer);
+
+  // The element array binding is recorded in the vertex array object
+  crb::Graphics::State::bindVertexArray(buffers.vertexArray);
+  crb::Graphics::State::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.indexBuffer);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesSize, NULL, usage);
+  crb::Graphics::State::bindBuffer(GL_ARRAY_BUFFER, buffers.vertexBuffer);
+  glBufferData(GL_ARRAY_BUFFER, verticesSize, NULL, usage);
+
+  layout.apply();
+
+  crb::Graphics::State::bindVertexArray(0);
+  crb::Graphics::State::bindBuffer(GL_ARRAY_BUFFER, 0);
+  return buffers;
+}
+
+void crb::Graphics::uploadMeshBuffers(const crb::Graphics::MeshBuffers& buffers, const void* vertices, const GLsizeiptr verticesSize, const GLuint indices[], const GLsizeiptr indicesSize)
+{
+  crb::Graphics::State::bindVertexArray(buffers.vertexArray);
+  crb::Graphics::State::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.indexBuffer);
+  glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indicesSize, indices);
+  crb::Graphics::State::bindBuffer(GL_ARRAY_BUFFER, buffers.vertexBuffer);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, verticesSize, vertices);
+
+  crb::Graphics::State::bindVertexArray(0);
+  crb::Graphics::State::bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void crb::Graphics::deleteMeshBuffers(crb::Graphics::MeshBuffers& buffers)
+{
+  crb::Graphics::State::forgetVertexArray(buffers.vertexArray);
+  glDeleteVertexArrays(1, &buffers.vertexArray);
+  crb::Graphics::State::forgetBuffer(buffers.vertexBuffer);
+  glDeleteBuffers(1, &buffers.vertexBuffer);
+  crb::Graphics::State::forgetBuffer(buffers.indexBuffer);
+  glDeleteBuffers(1, &buffers.indexBuffer);
+  buffers = {};
+}
+
+crb::Graphics::DeletionQueue::~DeletionQueue()
+{
+  for (Batch& batch : this->batches)
+  {
+    glDeleteSync(batch.fence);
+    for (std::function<void()>& action : batch.actions)
+    {
+      action();
+    }
+  }
+  for (std::function<void()>& action : this->current)
+  {
+    action();
+  }
+  for (crb::Graphics::MeshBuffers& buffers : this->pool)
+  {
+    crb::Graphics::deleteMeshBuffers(buffers);
+  }
+}
+
+void crb::Graphics::DeletionQueue::deleteBuffer(const GLuint buffer)
+{
+  // Forgetting right away, the name must not be bound from the shadow state again
+  crb::Graphics::State::forgetBuffer(buffer);
+  this->defer([buffer]()
+  {
+    glDeleteBuffers(1, &buffer);
+  });
+}
+
+void crb::Graphics::DeletionQueue::deleteVertexArray(const GLuint vertexArray)
+{
+  crb::Graphics::State::forgetVertexArray(vertexArray);
+  this->defer([vertexArray]()
+  {
+    glDeleteVertexArrays(1, &vertexArray);
+  });
+}
+
+void crb::Graphics::DeletionQueue::recycle(const crb::Graphics::MeshBuffers& buffers)
+{
+  this->defer([this, buffers]()
+  {
+    crb::Graphics::MeshBuffers released {buffers};
+    if (this->pool.size() < this->poolCapacity)
+    {
+      this->pool.push_back(released);
+    }
+    else
+    {
+      crb::Graphics::deleteMeshBuffers(released);
+    }
+  });
+}
+
+bool crb::Graphics::DeletionQueue::reuse(const crb::Graphics::VertexLayout& layout, const GLsizeiptr verticesSize, const GLsizeiptr indicesSize, crb::Graphics::MeshBuffers& oBuffers)
+{
+  std::size_t best = this->pool.size();
+  for (std::size_t i = 0; i < this->pool.size(); i++)
+  {
+    const crb::Graphics::MeshBuffers& buffers = this->pool[i];
+    if (buffers.layout != &layout || buffers.verticesSize < verticesSize || buffers.indicesSize < indicesSize)
+    {
+      continue;
+    }
+    if (best == this->pool.size() || buffers.verticesSize + buffers.indicesSize < this->pool[best].verticesSize + this->pool[best].indicesSize)
+    {
+      best = i;
+    }
+  }
+  if (best == this->pool.size())
+  {
+    return false;
+  }
+
+  oBuffers = this->pool[best];
+  this->pool[best] = this->pool.back();
+  this->pool.pop_back();
+  this->reusedCount++;
+  return true;
+}
+
+void crb::Graphics::DeletionQueue::collect()
+{
+  if (!this->current.empty())
+  {
+    Batch batch;
+    batch.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    batch.actions.swap(this->current);
+    this->batches.push_back(std::move(batch));
+  }
+
+  // Fences signal in order, so the first unsignaled one ends the search
+  while (!this->batches.empty())
+  {
+    Batch& batch = this->batches.front();
+    const GLenum status = glClientWaitSync(batch.fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+    {
+      break;
+    }
+    glDeleteSync(batch.fence);
+    for (std::function<void()>& action : batch.actions)
+    {
+      action();
+    }
+    this->batches.pop_front();
+  }
+}
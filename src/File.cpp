@@ -1,5 +1,8 @@
 #include "CRobes/File.hpp"
 
+#include <filesystem>
+#include <system_error>
+
 std::string crb::File::getContents(const std::string& path)
 {
   std::ifstream file(path);
@@ -13,3 +16,40 @@ std::string crb::File::getContents(const std::string& path)
   buffer << file.rdbuf();
   return buffer.str();
 }
+
+bool crb::File::getBinaryContents(const std::string& path, std::vector<char>& oContents)
+{
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open())
+  {
+    return false;
+  }
+
+  const std::streamsize size = file.tellg();
+  if (size < 0)
+  {
+    return false;
+  }
+  oContents.resize((std::size_t)size);
+  file.seekg(0);
+  return (bool)file.read(oContents.data(), size);
+}
+
+bool crb::File::setBinaryContents(const std::string& path, const void* data, std::size_t size)
+{
+  const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+  std::error_code error;
+  if (!parent.empty())
+  {
+    std::filesystem::create_directories(parent, error);
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    std::cerr << "Failed to write file (" << path << ")!\n";
+    return false;
+  }
+  file.write((const char*)data, (std::streamsize)size);
+  return (bool)file;
+}
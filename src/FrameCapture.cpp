@@ -0,0 +1,174 @@
+#include "CRobes/FrameCapture.hpp"
+
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+crb::FrameCapture::~FrameCapture()
+{
+  this->finish();
+  for (crb::FrameCapture::Slot& slot : this->slots)
+  {
+    if (slot.buffer != 0)
+    {
+      crb::Graphics::State::forgetBuffer(slot.buffer);
+      glDeleteBuffers(1, &slot.buffer);
+    }
+  }
+}
+
+void crb::FrameCapture::capture(const GLuint framebuffer, const unsigned int width, const unsigned int height)
+{
+  this->frame++;
+
+  std::string path;
+  if (!this->requests.empty())
+  {
+    path = this->requests.front();
+    this->requests.pop_front();
+  }
+  else if (this->interval > 0 && this->frame % this->interval == 0)
+  {
+    std::ostringstream stream;
+    stream << this->prefix << std::setw(6) << std::setfill('0') << this->frame << ".png";
+    path = stream.str();
+  }
+
+  this->poll();
+  if (path.empty())
+  {
+    return;
+  }
+
+  crb::FrameCapture::Slot& slot = this->slots[this->nextSlot];
+  if (slot.fence != NULL)
+  {
+    std::lock_guard<std::mutex> lock {this->mutex};
+    this->droppedCaptures++;
+    return;
+  }
+
+  const GLsizeiptr size = (GLsizeiptr)width * height * 4;
+  if (slot.buffer == 0)
+  {
+    glGenBuffers(1, &slot.buffer);
+  }
+  crb::Graphics::State::bindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+  if (slot.size != size)
+  {
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+    slot.size = size;
+  }
+
+  // Only queues the copy, the pixels are mapped once the fence is signaled
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+  glReadBuffer(framebuffer == 0 ? GL_BACK : GL_COLOR_ATTACHMENT0);
+  glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+  crb::Graphics::State::bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  slot.width = width;
+  slot.height = height;
+  slot.path = path;
+  this->nextSlot = (this->nextSlot + 1) % RING_SIZE;
+}
+
+void crb::FrameCapture::poll()
+{
+  // Oldest slot first, so that captures are encoded in order
+  for (std::size_t i = 0; i < RING_SIZE; i++)
+  {
+    crb::FrameCapture::Slot& slot = this->slots[(this->nextSlot + i) % RING_SIZE];
+    if (slot.fence == NULL)
+    {
+      continue;
+    }
+    const GLenum status = glClientWaitSync(slot.fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+    {
+      break;
+    }
+    this->_encode(slot, false);
+  }
+}
+
+void crb::FrameCapture::finish()
+{
+  for (std::size_t i = 0; i < RING_SIZE; i++)
+  {
+    crb::FrameCapture::Slot& slot = this->slots[(this->nextSlot + i) % RING_SIZE];
+    if (slot.fence == NULL)
+    {
+      continue;
+    }
+    while (glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000u) == GL_TIMEOUT_EXPIRED)
+    {}
+    this->_encode(slot, true);
+  }
+
+  std::unique_lock<std::mutex> lock {this->mutex};
+  this->encoded.wait(lock, [this]() { return this->pendingEncodes == 0; });
+}
+
+void crb::FrameCapture::_encode(crb::FrameCapture::Slot& slot, const bool wait)
+{
+  glDeleteSync(slot.fence);
+  slot.fence = NULL;
+
+  {
+    std::unique_lock<std::mutex> lock {this->mutex};
+    if (wait)
+    {
+      this->encoded.wait(lock, [this]() { return this->pendingEncodes < MAX_PENDING_ENCODES; });
+    }
+    else if (this->pendingEncodes >= MAX_PENDING_ENCODES)
+    {
+      this->droppedCaptures++;
+      return;
+    }
+    this->pendingEncodes++;
+  }
+
+  // A single copy on the render thread, everything else happens on the encoder thread
+  std::shared_ptr<std::vector<GLubyte>> pixels = std::make_shared<std::vector<GLubyte>>((std::size_t)slot.size);
+  crb::Graphics::State::bindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+  const GLubyte* mapped = (const GLubyte*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot.size, GL_MAP_READ_BIT);
+  if (mapped != NULL)
+  {
+    std::memcpy(pixels->data(), mapped, (std::size_t)slot.size);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  crb::Graphics::State::bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  const std::string path = slot.path;
+  const unsigned int width = slot.width;
+  const unsigned int height = slot.height;
+  const bool mappedPixels = mapped != NULL;
+  this->encoder.submit([this, pixels, path, width, height, mappedPixels]()
+  {
+    // Dropping the alpha channel in place, since blending leaves it meaningless
+    GLubyte* data = pixels->data();
+    const std::size_t pixelCount = (std::size_t)width * height;
+    for (std::size_t i = 0; i < pixelCount; i++)
+    {
+      std::memmove(data + i * 3, data + i * 4, 3);
+    }
+
+    const bool written = mappedPixels && crb::Image::saveToPNG(path, pixels->data(), width, height, false, true);
+    {
+      std::lock_guard<std::mutex> lock {this->mutex};
+      this->pendingEncodes--;
+      if (written)
+      {
+        this->writtenCaptures++;
+      }
+      else
+      {
+        this->droppedCaptures++;
+      }
+    }
+    this->encoded.notify_all();
+  });
+}
@@ -0,0 +1,142 @@
+#include "CRobes/FrameStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+  // Nearest-rank percentile of sorted values
+  double getPercentile(const std::vector<double>& sorted, const double percentile)
+  {
+    const std::size_t rank = (std::size_t)std::ceil(percentile / 100.0 * sorted.size());
+    return sorted[std::min(std::max(rank, (std::size_t)1u), sorted.size()) - 1];
+  }
+}
+
+double crb::FrameStats::getBucketLimit(const std::size_t bucket)
+{
+  return HISTOGRAM_START * std::exp2((double)bucket / BUCKETS_PER_OCTAVE);
+}
+
+void crb::FrameStats::record(const double milliseconds)
+{
+  this->frameTimes[this->frameCount % this->frameTimes.size()] = milliseconds;
+  this->frameCount++;
+  if (milliseconds > this->targetMilliseconds)
+  {
+    this->missedFrames++;
+  }
+
+  std::size_t bucket {0u};
+  if (milliseconds > HISTOGRAM_START)
+  {
+    bucket = (std::size_t)std::ceil(std::log2(milliseconds / HISTOGRAM_START) * BUCKETS_PER_OCTAVE);
+  }
+  this->histogram[std::min(bucket, BUCKET_COUNT - 1)]++;
+}
+
+void crb::FrameStats::reset()
+{
+  std::fill(this->histogram.begin(), this->histogram.end(), 0u);
+  this->frameCount = 0;
+  this->missedFrames = 0;
+}
+
+crb::FrameStats::Summary crb::FrameStats::getSummary(const std::size_t frames) const
+{
+  const std::size_t kept = std::min(this->frameCount, this->frameTimes.size());
+  const std::size_t count = frames == 0 ? kept : std::min(frames, kept);
+
+  crb::FrameStats::Summary summary;
+  if (count == 0)
+  {
+    return summary;
+  }
+
+  std::vector<double> sorted;
+  this->_copyLatest(count, sorted);
+  std::sort(sorted.begin(), sorted.end());
+
+  double total {0.0};
+  for (const double frameTime : sorted)
+  {
+    total += frameTime;
+  }
+
+  summary.frames = count;
+  summary.missed = sorted.end() - std::upper_bound(sorted.begin(), sorted.end(), this->targetMilliseconds);
+  summary.min = sorted.front();
+  summary.max = sorted.back();
+  summary.mean = total / count;
+  summary.p50 = getPercentile(sorted, 50.0);
+  summary.p95 = getPercentile(sorted, 95.0);
+  summary.p99 = getPercentile(sorted, 99.0);
+  summary.p999 = getPercentile(sorted, 99.9);
+  return summary;
+}
+
+bool crb::FrameStats::writeJSON(const std::string& path) const
+{
+  std::ofstream file(path);
+  if (!file.is_open())
+  {
+    std::cerr << "Failed to write the frame statistics (" << path << ")!\n";
+    return false;
+  }
+
+  const crb::FrameStats::Summary summary = this->getSummary();
+  file << "{\n"
+       << "  \"totalFrames\": " << this->frameCount << ",\n"
+       << "  \"totalMissed\": " << this->missedFrames << ",\n"
+       << "  \"targetMs\": " << this->targetMilliseconds << ",\n"
+       << "  \"window\": {"
+       << "\"frames\": " << summary.frames
+       << ", \"missed\": " << summary.missed
+       << ", \"minMs\": " << summary.min
+       << ", \"maxMs\": " << summary.max
+       << ", \"meanMs\": " << summary.mean
+       << ", \"p50Ms\": " << summary.p50
+       << ", \"p95Ms\": " << summary.p95
+       << ", \"p99Ms\": " << summary.p99
+       << ", \"p999Ms\": " << summary.p999
+       << "},\n"
+       << "  \"histogram\": [";
+  for (std::size_t i = 0; i < BUCKET_COUNT; i++)
+  {
+    file << (i == 0 ? "\n" : ",\n") << "    {\"upToMs\": " << getBucketLimit(i) << ", \"frames\": " << this->histogram[i] << '}';
+  }
+  file << "\n  ]\n}\n";
+  return (bool)file;
+}
+
+bool crb::FrameStats::writeCSV(const std::string& path) const
+{
+  std::ofstream file(path);
+  if (!file.is_open())
+  {
+    std::cerr << "Failed to write the frame statistics (" << path << ")!\n";
+    return false;
+  }
+
+  const std::size_t kept = std::min(this->frameCount, this->frameTimes.size());
+  std::vector<double> frameTimes;
+  this->_copyLatest(kept, frameTimes);
+
+  file << "frame,ms\n";
+  for (std::size_t i = 0; i < kept; i++)
+  {
+    file << this->frameCount - kept + i << ',' << frameTimes[i] << '\n';
+  }
+  return (bool)file;
+}
+
+void crb::FrameStats::_copyLatest(const std::size_t frames, std::vector<double>& oFrameTimes) const
+{
+  oFrameTimes.resize(frames);
+  for (std::size_t i = 0; i < frames; i++)
+  {
+    oFrameTimes[i] = this->frameTimes[(this->frameCount - frames + i) % this->frameTimes.size()];
+  }
+}
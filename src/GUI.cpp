@@ -3,12 +3,14 @@
 crb::GUI::Element::Element(const crb::Space::Vec2& position, const float x, const float y, const float width, const float height)
 : position(position)
 {
-  GLfloat vertices[] =
+  constexpr GLushort ZERO = crb::Graphics::toUnorm16(0.f);
+  constexpr GLushort ONE = crb::Graphics::toUnorm16(1.f);
+  const crb::GUI::Element::Vertex vertices[] =
   {
-    0.f,   0.f,  0.f, 0.f, 0.f,
-    width, 0.f,  0.f, 1.f, 0.f,
-    0.f,   height, 0.f, 0.f, 1.f,
-    width, height, 0.f, 1.f, 1.f,
+    {0.f,   0.f,    ZERO, ZERO},
+    {width, 0.f,    ONE,  ZERO},
+    {0.f,   height, ZERO, ONE},
+    {width, height, ONE,  ONE},
   };
   GLuint indices[] =
   {
@@ -16,20 +18,22 @@ crb::GUI::Element::Element(const crb::Space::Vec2& position, const float x, cons
     0, 3, 2,
   };
 
-  this->VAO = new crb::Graphics::VAO();
-  this->VBO = new crb::Graphics::VBO(vertices, (GLsizeiptr)sizeof(vertices));
-  this->EBO = new crb::Graphics::EBO(indices, (GLsizeiptr)sizeof(indices));
-
-  this->VAO->LinkAttribute(*this->VBO, 0, 3, GL_FLOAT, 5 * sizeof(GLfloat), (void*)0);
-  this->VAO->LinkAttribute(*this->VBO, 1, 2, GL_FLOAT, 5 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat)));
-
-  this->VAO->Unbind();
-  this->VBO->Unbind();
-  this->EBO->Unbind();
+  this->mesh = crb::Graphics::createMesh(
+    crb::GUI::Element::VertexFormat::LAYOUT,
+    vertices,
+    (GLsizeiptr)sizeof(vertices),
+    indices,
+    (GLsizeiptr)sizeof(indices)
+  );
 }
 
 void crb::GUI::Element::render(const crb::Graphics::Shader& shader) const
 {
+  const GLuint vertexArray = this->getVertexArrayID();
+  if (vertexArray == 0)
+  {
+    return;
+  }
   crb::Space::Mat4 appliedMatrix {1.f};
   appliedMatrix = crb::Space::translate(appliedMatrix, {
     this->position.x,
@@ -37,7 +41,6 @@ void crb::GUI::Element::render(const crb::Graphics::Shader& shader) const
     0.f,
   });
   shader.SetMatrix4(appliedMatrix, "model");
-  this->VAO->Bind();
+  crb::Graphics::State::bindVertexArray(vertexArray);
   glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, NULL);
-  this->VAO->Unbind();
 }
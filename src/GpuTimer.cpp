@@ -0,0 +1,136 @@
+#include "CRobes/GpuTimer.hpp"
+
+#include <cstring>
+
+crb::Graphics::GpuTimer::~GpuTimer()
+{
+  for (crb::Graphics::GpuTimer::Frame& frame : this->frames)
+  {
+    if (!frame.queries.empty())
+    {
+      glDeleteQueries((GLsizei)frame.queries.size(), frame.queries.data());
+    }
+  }
+}
+
+bool crb::Graphics::GpuTimer::isRendererDeferred()
+{
+  const GLubyte* renderer = glGetString(GL_RENDERER);
+  return renderer != NULL && std::strstr((const char*)renderer, "llvmpipe") != NULL;
+}
+
+double crb::Graphics::GpuTimer::getMilliseconds(const std::string& name) const
+{
+  const auto iterator = this->milliseconds.find(name);
+  return iterator != this->milliseconds.end() ? iterator->second : 0.0;
+}
+
+void crb::Graphics::GpuTimer::beginFrame()
+{
+  while (!this->openScopes.empty())
+  {
+    this->end();
+  }
+
+  // Oldest frame first, as the GPU finishes them in order
+  this->current = (this->current + 1) % FRAME_COUNT;
+  for (std::size_t i = 0; i < FRAME_COUNT; i++)
+  {
+    if (!this->_resolve(this->frames[(this->current + i) % FRAME_COUNT]))
+    {
+      break;
+    }
+  }
+
+  crb::Graphics::GpuTimer::Frame& frame = this->frames[this->current];
+  if (frame.pending)
+  {
+    this->droppedFrames++;
+  }
+  frame.scopes.clear();
+  frame.usedQueries = 0;
+  frame.pending = false;
+
+#if defined(CRB_ENABLE_PROFILER)
+  // Maps GPU timestamps onto the profiler clock
+  GLint64 gpuTime {0};
+  glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+  frame.clockOffset = (std::int64_t)crb::Profiler::now() - (std::int64_t)gpuTime;
+#endif
+}
+
+void crb::Graphics::GpuTimer::begin(const char* name)
+{
+  crb::Graphics::GpuTimer::Frame& frame = this->frames[this->current];
+  this->openScopes.push_back(frame.scopes.size());
+  frame.scopes.push_back({name, this->_acquire(), 0u});
+}
+
+void crb::Graphics::GpuTimer::end()
+{
+  if (this->openScopes.empty())
+  {
+    std::cerr << "Ended a GPU timer scope that was never begun!\n";
+    return;
+  }
+  crb::Graphics::GpuTimer::Frame& frame = this->frames[this->current];
+  frame.scopes[this->openScopes.back()].endQuery = this->_acquire();
+  frame.pending = true;
+  this->openScopes.pop_back();
+}
+
+std::size_t crb::Graphics::GpuTimer::_acquire()
+{
+  crb::Graphics::GpuTimer::Frame& frame = this->frames[this->current];
+  if (frame.usedQueries == frame.queries.size())
+  {
+    frame.queries.push_back(0u);
+    glGenQueries(1, &frame.queries.back());
+  }
+
+  // Deferred renderers run the commands of a batch tile by tile, so a timestamp recorded between
+  // draws means nothing. Flushing around the query puts it in a batch of its own, run once the
+  // draws before it are done.
+  if (this->flushQueries)
+  {
+    glFlush();
+  }
+  glQueryCounter(frame.queries[frame.usedQueries], GL_TIMESTAMP);
+  if (this->flushQueries)
+  {
+    glFlush();
+  }
+  return frame.usedQueries++;
+}
+
+bool crb::Graphics::GpuTimer::_resolve(crb::Graphics::GpuTimer::Frame& frame)
+{
+  if (!frame.pending)
+  {
+    return true;
+  }
+
+  // Queries complete in order, so the last one tells for the whole frame
+  GLint available {GL_FALSE};
+  glGetQueryObjectiv(frame.queries[frame.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+  if (available == GL_FALSE)
+  {
+    return false;
+  }
+
+  this->milliseconds.clear();
+  for (const crb::Graphics::GpuTimer::Scope& scope : frame.scopes)
+  {
+    GLuint64 start {0u};
+    GLuint64 end {0u};
+    glGetQueryObjectui64v(frame.queries[scope.startQuery], GL_QUERY_RESULT, &start);
+    glGetQueryObjectui64v(frame.queries[scope.endQuery], GL_QUERY_RESULT, &end);
+    this->milliseconds[scope.name] += (double)(end - start) / 1000000.0;
+
+#if defined(CRB_ENABLE_PROFILER)
+    crb::Profiler::recordTrack("GPU", scope.name, (std::uint64_t)((std::int64_t)start + frame.clockOffset), (std::uint64_t)((std::int64_t)end + frame.clockOffset));
+#endif
+  }
+  frame.pending = false;
+  return true;
+}
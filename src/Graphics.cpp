@@ -1,52 +1,241 @@
 #include "CRobes/Graphics.hpp"
 
-crb::Graphics::Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath)
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+  // Identifies cache files written by this engine
+  constexpr std::uint32_t BINARY_CACHE_MAGIC {0x50425243u};
+
+  struct BinaryCacheHeader
+  {
+    std::uint32_t magic;
+    std::uint32_t format;
+    std::uint32_t length;
+  };
+
+  // 64-bit FNV-1a
+  std::uint64_t hash(const std::string& text, std::uint64_t value = 14695981039346656037ull)
+  {
+    for (const char character : text)
+    {
+      value ^= (unsigned char)character;
+      value *= 1099511628211ull;
+    }
+    return value;
+  }
+
+  std::string getGlString(GLenum name)
+  {
+    const GLubyte* value = glGetString(name);
+    return value != NULL ? (const char*)value : "";
+  }
+
+  bool isParallelCompilationSupported()
+  {
+    return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+  }
+
+  // Lets the driver pick its number of compiler threads, once per process
+  void enableParallelCompilation()
+  {
+    static bool enabled {false};
+    if (enabled || !isParallelCompilationSupported())
+    {
+      return;
+    }
+    if (GLEW_KHR_parallel_shader_compile)
+    {
+      glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+    }
+    else
+    {
+      glMaxShaderCompilerThreadsARB(0xFFFFFFFFu);
+    }
+    enabled = true;
+  }
+
+  bool isBinaryCacheSupported()
+  {
+    if (glGetProgramBinary == NULL || glProgramBinary == NULL || glProgramParameteri == NULL)
+    {
+      return false;
+    }
+    GLint formatCount {0};
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    return formatCount > 0;
+  }
+
+  // The key covers the sources and the driver, so updated shaders or drivers miss the cache
+  std::string getBinaryCachePath(const std::string& directory, const std::string& vertexSource, const std::string& fragmentSource)
+  {
+    std::uint64_t key = hash(vertexSource);
+    key = hash(std::string(1, '\0') + fragmentSource, key);
+    key = hash(std::string(1, '\0') + getGlString(GL_VENDOR), key);
+    key = hash(std::string(1, '\0') + getGlString(GL_RENDERER), key);
+    key = hash(std::string(1, '\0') + getGlString(GL_VERSION), key);
+
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", (unsigned long long)key);
+    return directory + "/" + name + ".bin";
+  }
+}
+
+crb::Graphics::Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, const crb::Graphics::Shader::Compilation compilation)
 {
+  CRB_PROFILE_SCOPE("Shader::Shader");
   // Shader Source Codes
   const std::string vertexShaderSource = crb::File::getContents(vertexPath);
   const std::string fragmentShaderSource = crb::File::getContents(fragmentPath);
 
-  const char* vertexShaderSourceC = vertexShaderSource.c_str();
-  const char* fragmentShaderSourceC = fragmentShaderSource.c_str();
+  const bool useCache = !binaryCacheDirectory.empty() && isBinaryCacheSupported();
+  if (useCache)
+  {
+    this->cachePath = getBinaryCachePath(binaryCacheDirectory, vertexShaderSource, fragmentShaderSource);
+    if (this->_loadBinary(this->cachePath))
+    {
+      this->fromBinaryCache = true;
+      this->_prepare();
+      return;
+    }
+  }
+
+  if (compilation == crb::Graphics::Shader::Deferred)
+  {
+    enableParallelCompilation();
+  }
+  this->_submit(vertexShaderSource, fragmentShaderSource, useCache);
+  if (compilation == crb::Graphics::Shader::Blocking)
+  {
+    this->finish();
+  }
+}
+
+bool crb::Graphics::Shader::poll()
+{
+  if (this->ready || this->failed)
+  {
+    return this->ready;
+  }
+  if (isParallelCompilationSupported())
+  {
+    GLint completed {GL_FALSE};
+    glGetProgramiv(this->ID, GL_COMPLETION_STATUS_KHR, &completed);
+    if (!completed)
+    {
+      return false;
+    }
+  }
+  return this->finish();
+}
+
+bool crb::Graphics::Shader::finish()
+{
+  CRB_PROFILE_SCOPE("Shader::finish");
+  if (this->ready || this->failed)
+  {
+    return this->ready;
+  }
+  const bool linked = this->_link();
+  if (linked && !this->cachePath.empty())
+  {
+    this->_saveBinary(this->cachePath);
+  }
+  this->cachePath.clear();
+  if (!linked)
+  {
+    // A broken program is never used, so its uniforms are not reflected
+    this->failed = true;
+    return false;
+  }
+  this->_prepare();
+  return true;
+}
+
+void crb::Graphics::Shader::BindUniformBlock(const std::string& block, GLuint binding) const
+{
+  const GLuint blockIndex = glGetUniformBlockIndex(this->ID, block.c_str());
+  if (blockIndex != GL_INVALID_INDEX)
+  {
+    glUniformBlockBinding(this->ID, blockIndex, binding);
+  }
+}
+
+GLint crb::Graphics::Shader::getUniformLocation(const std::string& uniform) const
+{
+  auto slot = this->uniformSlots.find(uniform);
+  return slot != this->uniformSlots.end() ? this->uniforms[slot->second].location : -1;
+}
+
+void crb::Graphics::Shader::SetInt(int value, const crb::Graphics::Shader::Uniform<int>& uniform) const
+{
+  if (uniform.isValid() && this->_cache(uniform.slot, &value, sizeof(value)))
+  {
+    glUniform1i(this->uniforms[uniform.slot].location, value);
+  }
+}
+
+void crb::Graphics::Shader::SetMatrix4(const crb::Space::Mat4& mat, const crb::Graphics::Shader::Uniform<crb::Space::Mat4>& uniform) const
+{
+  const GLfloat* values = crb::Space::valuePointer(mat);
+  if (uniform.isValid() && this->_cache(uniform.slot, values, 16 * sizeof(GLfloat)))
+  {
+    glUniformMatrix4fv(this->uniforms[uniform.slot].location, 1, GL_FALSE, values);
+  }
+}
+
+void crb::Graphics::Shader::_submit(const std::string& vertexSource, const std::string& fragmentSource, const bool retrievable)
+{
+  const char* vertexShaderSourceC = vertexSource.c_str();
+  const char* fragmentShaderSourceC = fragmentSource.c_str();
 
   // Shaders
-  GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-  GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+  this->vertexStage = glCreateShader(GL_VERTEX_SHADER);
+  this->fragmentStage = glCreateShader(GL_FRAGMENT_SHADER);
 
-  glShaderSource(vertexShader, 1, &vertexShaderSourceC, NULL);
-  glShaderSource(fragmentShader, 1, &fragmentShaderSourceC, NULL);
+  glShaderSource(this->vertexStage, 1, &vertexShaderSourceC, NULL);
+  glShaderSource(this->fragmentStage, 1, &fragmentShaderSourceC, NULL);
 
-  glCompileShader(vertexShader);
-  glCompileShader(fragmentShader);
+  glCompileShader(this->vertexStage);
+  glCompileShader(this->fragmentStage);
 
+  // Shader Program, linked without waiting for the stages to compile
+  this->ID = glCreateProgram();
+  if (retrievable)
+  {
+    glProgramParameteri(this->ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+  glAttachShader(this->ID, this->vertexStage);
+  glAttachShader(this->ID, this->fragmentStage);
+  glLinkProgram(this->ID);
+}
+
+bool crb::Graphics::Shader::_link()
+{
   // Info Log
   int success {0};
   char infoLog[crb::INFO_LOG_SIZE];
 
   // Validating the Vertex Shader
-  glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
+  glGetShaderiv(this->vertexStage, GL_COMPILE_STATUS, &success);
   if (!success)
   {
-    glGetShaderInfoLog(vertexShader, crb::INFO_LOG_SIZE, NULL, infoLog);
+    glGetShaderInfoLog(this->vertexStage, crb::INFO_LOG_SIZE, NULL, infoLog);
     std::cerr << "Failed to compile the vertex shader!\n";
     std::cerr << "Error: " << infoLog << '\n';
   }
 
   // Validating the Fragment Shader
-  glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
+  glGetShaderiv(this->fragmentStage, GL_COMPILE_STATUS, &success);
   if (!success)
   {
-    glGetShaderInfoLog(fragmentShader, crb::INFO_LOG_SIZE, NULL, infoLog);
+    glGetShaderInfoLog(this->fragmentStage, crb::INFO_LOG_SIZE, NULL, infoLog);
     std::cerr << "Failed to compile the fragment shader!\n";
     std::cerr << "Error: " << infoLog << '\n';
   }
 
-  // Shader Program
-  this->ID = glCreateProgram();
-  glAttachShader(this->ID, vertexShader);
-  glAttachShader(this->ID, fragmentShader);
-  glLinkProgram(this->ID);
-
   // Validating the Shader Program
   glGetProgramiv(this->ID, GL_LINK_STATUS, &success);
   if (!success)
@@ -57,24 +246,152 @@ crb::Graphics::Shader::Shader(const std::string& vertexPath, const std::string&
   }
 
   // Deleting the Shaders
-  glDeleteShader(vertexShader);
-  glDeleteShader(fragmentShader);
+  glDeleteShader(this->vertexStage);
+  glDeleteShader(this->fragmentStage);
+  this->vertexStage = 0;
+  this->fragmentStage = 0;
+  return success;
+}
+
+void crb::Graphics::Shader::_prepare()
+{
+  this->_reflect();
+  this->BindUniformBlock(crb::CAMERA_BLOCK_NAME, crb::CAMERA_BLOCK_BINDING);
+  this->ready = true;
+}
+
+bool crb::Graphics::Shader::_loadBinary(const std::string& path)
+{
+  std::vector<char> contents;
+  if (!crb::File::getBinaryContents(path, contents) || contents.size() < sizeof(BinaryCacheHeader))
+  {
+    return false;
+  }
+
+  BinaryCacheHeader header;
+  std::memcpy(&header, contents.data(), sizeof(header));
+  if (header.magic != BINARY_CACHE_MAGIC || header.length != contents.size() - sizeof(header))
+  {
+    return false;
+  }
+
+  this->ID = glCreateProgram();
+  glProgramBinary(this->ID, header.format, contents.data() + sizeof(header), header.length);
+
+  // Drivers reject binaries they can no longer use, which falls back to compiling
+  int success {0};
+  glGetProgramiv(this->ID, GL_LINK_STATUS, &success);
+  if (!success)
+  {
+    crb::Graphics::State::forgetProgram(this->ID);
+    glDeleteProgram(this->ID);
+    this->ID = 0;
+    return false;
+  }
+  return true;
+}
+
+void crb::Graphics::Shader::_saveBinary(const std::string& path) const
+{
+  GLint length {0};
+  glGetProgramiv(this->ID, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0)
+  {
+    return;
+  }
+
+  std::vector<char> contents(sizeof(BinaryCacheHeader) + length);
+  GLenum format {GL_NONE};
+  glGetProgramBinary(this->ID, length, NULL, &format, contents.data() + sizeof(BinaryCacheHeader));
+
+  const BinaryCacheHeader header {BINARY_CACHE_MAGIC, (std::uint32_t)format, (std::uint32_t)length};
+  std::memcpy(contents.data(), &header, sizeof(header));
+  crb::File::setBinaryContents(path, contents.data(), contents.size());
 }
 
-crb::Graphics::VBO::VBO(GLfloat vertices[], GLsizeiptr verticesSize)
+void crb::Graphics::Shader::_reflect()
+{
+  GLint uniformCount {0};
+  GLint maxNameLength {0};
+  glGetProgramiv(this->ID, GL_ACTIVE_UNIFORMS, &uniformCount);
+  glGetProgramiv(this->ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+  std::vector<GLchar> name(maxNameLength + 1);
+  for (GLint i = 0; i < uniformCount; i++)
+  {
+    GLsizei nameLength {0};
+    GLint size {0};
+    crb::Graphics::Shader::UniformSlot slot;
+    glGetActiveUniform(this->ID, i, (GLsizei)name.size(), &nameLength, &size, &slot.type, name.data());
+
+    // Uniforms inside uniform blocks have no location
+    slot.location = glGetUniformLocation(this->ID, name.data());
+    if (slot.location < 0)
+    {
+      continue;
+    }
+
+    // Arrays are reported as "name[0]" but are also looked up as "name"
+    std::string key {name.data(), (std::size_t)nameLength};
+    if (key.size() > 3 && key.compare(key.size() - 3, 3, "[0]") == 0)
+    {
+      this->uniformSlots.emplace(key.substr(0, key.size() - 3), this->uniforms.size());
+    }
+    this->uniformSlots.emplace(std::move(key), this->uniforms.size());
+    this->uniforms.push_back(slot);
+  }
+}
+
+bool crb::Graphics::Shader::_cache(const std::size_t slot, const void* value, const std::size_t size) const
+{
+  crb::Graphics::Shader::UniformSlot& uniform = this->uniforms[slot];
+  if (uniform.cached && std::memcmp(uniform.value, value, size) == 0)
+  {
+    this->skippedUploads++;
+    return false;
+  }
+  std::memcpy(uniform.value, value, size);
+  uniform.cached = true;
+  return true;
+}
+
+crb::Graphics::VBO::VBO(const void* vertices, GLsizeiptr verticesSize, GLenum usage)
 {
   glGenBuffers(1, &this->ID);
   this->Bind();
-  glBufferData(GL_ARRAY_BUFFER, verticesSize, vertices, GL_STATIC_DRAW);
+  glBufferData(GL_ARRAY_BUFFER, verticesSize, vertices, usage);
+}
+
+void crb::Graphics::VBO::SetData(const void* vertices, GLsizeiptr verticesSize, GLenum usage)
+{
+  this->Bind();
+  glBufferData(GL_ARRAY_BUFFER, verticesSize, vertices, usage);
 }
 
-crb::Graphics::EBO::EBO(GLuint indices[], GLsizeiptr indicesSize)
+crb::Graphics::EBO::EBO(const GLuint indices[], GLsizeiptr indicesSize)
 {
   glGenBuffers(1, &this->ID);
   this->Bind();
   glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesSize, indices, GL_STATIC_DRAW);
 }
 
+crb::Graphics::UBO::UBO(GLsizeiptr size, GLuint binding)
+: binding(binding), size(size)
+{
+  glGenBuffers(1, &this->ID);
+  this->Bind();
+  glBufferData(GL_UNIFORM_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
+  this->Unbind();
+  this->BindBase();
+}
+
+void crb::Graphics::UBO::SetData(const void* data)
+{
+  this->Bind();
+  glBufferData(GL_UNIFORM_BUFFER, this->size, data, GL_DYNAMIC_DRAW);
+  this->Unbind();
+}
+
 void crb::Graphics::VAO::LinkAttribute(const crb::Graphics::VBO& VBO, GLuint layout, GLuint size, GLenum type, GLsizeiptr stride, const void* offset) const
 {
   VBO.Bind();
@@ -83,10 +400,17 @@ void crb::Graphics::VAO::LinkAttribute(const crb::Graphics::VBO& VBO, GLuint lay
   VBO.Unbind();
 }
 
+void crb::Graphics::VAO::LinkLayout(const crb::Graphics::VBO& VBO, const crb::Graphics::VertexLayout& layout) const
+{
+  VBO.Bind();
+  layout.apply();
+  VBO.Unbind();
+}
+
 crb::Graphics::Texture::Texture(const std::string& pngPath, GLenum type) : type(type)
 {
   glGenTextures(1, &this->ID);
-  glBindTexture(type, this->ID);
+  crb::Graphics::State::bindTexture(type, this->ID);
 
   GLubyte* data;
   unsigned int width;
@@ -112,6 +436,6 @@ crb::Graphics::Texture::Texture(const std::string& pngPath, GLenum type) : type(
   glTexParameteri(type, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
   glTexParameteri(type, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 
-  glBindTexture(type, 0);
+  crb::Graphics::State::bindTexture(type, 0);
   delete data;
 }
@@ -1,7 +1,20 @@
 #include "CRobes/Image.hpp"
 
+namespace
+{
+  void writeToVector(png_structp pngPointer, png_bytep data, png_size_t length)
+  {
+    std::vector<char>* output = (std::vector<char>*)png_get_io_ptr(pngPointer);
+    output->insert(output->end(), (const char*)data, (const char*)data + length);
+  }
+
+  void flushVector(png_structp)
+  {}
+}
+
 bool crb::Image::loadFromPNG(const std::string& path, GLubyte** oData, unsigned int &oWidth, unsigned int &oHeight, bool &oHasAlpha)
 {
+  CRB_PROFILE_SCOPE("Image::loadFromPNG");
   FILE* file = fopen(path.c_str(), "rb");
   if (!file)
   {
@@ -88,3 +101,62 @@ bool crb::Image::loadFromPNG(const std::string& path, GLubyte** oData, unsigned
   fclose(file);
   return true;
 }
+
+bool crb::Image::saveToPNG(const std::string& path, const GLubyte* data, const unsigned int width, const unsigned int height, const bool hasAlpha, const bool flipVertically)
+{
+  CRB_PROFILE_SCOPE("Image::saveToPNG");
+  png_structp pngPointer = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+  if (!pngPointer)
+  {
+    std::cerr << "Failed to create a write struct!\n";
+    return false;
+  }
+
+  png_infop pngInfoPointer = png_create_info_struct(pngPointer);
+  if (!pngInfoPointer)
+  {
+    std::cerr << "Failed to create an info struct!\n";
+    png_destroy_write_struct(&pngPointer, NULL);
+    return false;
+  }
+
+  // Encoded in memory first, so that the file is written in one go
+  std::vector<char> output;
+  const std::size_t rowBytes = (std::size_t)width * (hasAlpha ? 4 : 3);
+  png_bytep* rowPointers = (png_bytep*)malloc(sizeof(png_bytep) * height);
+
+  if (setjmp(png_jmpbuf(pngPointer)))
+  {
+    std::cerr << "Failed to encode the image (" << path << ")!\n";
+    free(rowPointers);
+    png_destroy_write_struct(&pngPointer, &pngInfoPointer);
+    return false;
+  }
+
+  png_set_write_fn(pngPointer, &output, writeToVector, flushVector);
+  png_set_IHDR(
+    pngPointer,
+    pngInfoPointer,
+    width,
+    height,
+    8,
+    hasAlpha ? PNG_COLOR_TYPE_RGB_ALPHA : PNG_COLOR_TYPE_RGB,
+    PNG_INTERLACE_NONE,
+    PNG_COMPRESSION_TYPE_DEFAULT,
+    PNG_FILTER_TYPE_DEFAULT
+  );
+
+  for (unsigned int y = 0; y < height; y++)
+  {
+    const unsigned int row = flipVertically ? height - 1 - y : y;
+    rowPointers[y] = (png_bytep)data + row * rowBytes;
+  }
+
+  png_write_info(pngPointer, pngInfoPointer);
+  png_write_image(pngPointer, rowPointers);
+  png_write_end(pngPointer, NULL);
+  free(rowPointers);
+  png_destroy_write_struct(&pngPointer, &pngInfoPointer);
+
+  return crb::File::setBinaryContents(path, output.data(), output.size());
+}
@@ -0,0 +1,67 @@
+#include "CRobes/MeshBuilder.hpp"
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  // Storage of recycled meshes, shared by every thread generating meshes
+  struct MeshPool
+  {
+    std::mutex                     mutex;
+    std::vector<crb::Solids::Mesh> meshes;
+  };
+
+  MeshPool& getMeshPool()
+  {
+    static MeshPool pool;
+    return pool;
+  }
+}
+
+void crb::Solids::MeshBuilder::recycle(crb::Solids::Mesh&& mesh)
+{
+  if (mesh.vertices.capacity() == 0 && mesh.indices.capacity() == 0)
+  {
+    return;
+  }
+  mesh.vertices.clear();
+  mesh.indices.clear();
+
+  MeshPool& pool = getMeshPool();
+  std::lock_guard<std::mutex> lock {pool.mutex};
+  if (pool.meshes.size() < POOL_CAPACITY)
+  {
+    pool.meshes.push_back(std::move(mesh));
+  }
+}
+
+void crb::Solids::MeshBuilder::begin(const std::size_t vertexCount, const std::size_t indexCount)
+{
+  this->mesh.vertices.clear();
+  this->mesh.indices.clear();
+  if (this->mesh.vertices.capacity() < vertexCount * crb::Solids::VERTEX_FLOATS)
+  {
+    MeshPool& pool = getMeshPool();
+    std::lock_guard<std::mutex> lock {pool.mutex};
+    if (!pool.meshes.empty())
+    {
+      // The storage held so far goes back to the pool rather than being freed
+      std::swap(this->mesh, pool.meshes.back());
+      if (pool.meshes.back().vertices.capacity() == 0 && pool.meshes.back().indices.capacity() == 0)
+      {
+        pool.meshes.pop_back();
+      }
+    }
+  }
+  this->mesh.vertices.reserve(vertexCount * crb::Solids::VERTEX_FLOATS);
+  this->mesh.indices.reserve(indexCount);
+}
+
+crb::Solids::Mesh crb::Solids::MeshBuilder::finish()
+{
+  crb::Solids::Mesh result {std::move(this->mesh)};
+  this->mesh = {};
+  return result;
+}
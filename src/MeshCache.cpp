@@ -0,0 +1,67 @@
+#include "CRobes/MeshCache.hpp"
+#include "CRobes/MeshBuilder.hpp"
+
+#include <iostream>
+#include <utility>
+
+bool crb::Solids::MeshCache::isCached(const crb::Solids::MeshCache::Key& key) const
+{
+  const auto entry = this->entries.find(key);
+  return entry != this->entries.end() && crb::Graphics::getMesh(entry->second.mesh) != NULL;
+}
+
+void crb::Solids::MeshCache::upload(const crb::Solids::MeshCache::Key& key, const crb::Solids::Mesh& mesh)
+{
+  // Several misses may have generated the same mesh, only the first one is uploaded
+  if (this->isCached(key))
+  {
+    return;
+  }
+  this->missCount++;
+  crb::Solids::MeshCache::Entry& entry = this->entries[key];
+  entry.mesh = crb::Graphics::createMesh(
+    *key.layout,
+    mesh.vertices.data(),
+    (GLsizeiptr)(mesh.vertices.size() * sizeof(GLfloat)),
+    mesh.indices.data(),
+    (GLsizeiptr)(mesh.indices.size() * sizeof(GLuint)),
+    this->deletionQueue
+  );
+  entry.bounds = crb::Solids::computeBounds(mesh.vertices.data(), mesh.vertices.size());
+  entry.vertexCount = (GLuint)mesh.indices.size();
+}
+
+std::optional<crb::Solids::Solid> crb::Solids::MeshCache::create(const crb::Space::Vec3& position, const crb::Solids::MeshCache::Key& key)
+{
+  std::optional<crb::Solids::Solid> solid = this->_share(position, key);
+  if (!solid.has_value())
+  {
+    std::cerr << "Created a solid from a mesh that is not cached!\n";
+    return std::nullopt;
+  }
+  this->hitCount++;
+  return solid;
+}
+
+std::optional<crb::Solids::Solid> crb::Solids::MeshCache::createPlane(const crb::Space::Vec3& position, const float length, const float width, const unsigned int segmentCount)
+{
+  const crb::Solids::MeshCache::Key key = crb::Solids::MeshCache::getPlaneKey(length, width, segmentCount);
+  if (this->isCached(key))
+  {
+    return this->create(position, key);
+  }
+  crb::Solids::Mesh mesh = crb::Solids::SolidFactory().generatePlane(length, width, segmentCount);
+  this->upload(key, mesh);
+  crb::Solids::MeshBuilder::recycle(std::move(mesh));
+  return this->_share(position, key);
+}
+
+std::optional<crb::Solids::Solid> crb::Solids::MeshCache::_share(const crb::Space::Vec3& position, const crb::Solids::MeshCache::Key& key)
+{
+  const auto entry = this->entries.find(key);
+  if (entry == this->entries.end() || !crb::Graphics::retainMesh(entry->second.mesh))
+  {
+    return std::nullopt;
+  }
+  return crb::Solids::Solid(position, entry->second.mesh, entry->second.bounds, entry->second.vertexCount, this->deletionQueue);
+}
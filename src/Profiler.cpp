@@ -0,0 +1,195 @@
+#include "CRobes/Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+  struct Event
+  {
+    const char*   name;
+    std::uint64_t start;
+    std::uint64_t end;
+  };
+
+  // The ring buffer of one thread. The lock is only contended while a trace is written.
+  struct Buffer
+  {
+    std::mutex         mutex;
+    std::vector<Event> events;
+    std::size_t        recorded {0u};
+    std::uint32_t      threadId {0u};
+    std::string        threadName;
+  };
+
+  struct Registry
+  {
+    std::mutex                                               mutex;
+    std::vector<std::shared_ptr<Buffer>>                     buffers;
+    std::unordered_map<std::string, std::shared_ptr<Buffer>> tracks;
+  };
+
+  Registry& getRegistry()
+  {
+    static Registry registry;
+    return registry;
+  }
+
+  // Must be called with the registry locked
+  std::shared_ptr<Buffer> createBuffer(Registry& registry)
+  {
+    std::shared_ptr<Buffer> buffer = std::make_shared<Buffer>();
+    buffer->events.resize(crb::Profiler::EVENT_CAPACITY);
+    buffer->threadId = (std::uint32_t)registry.buffers.size() + 1;
+    registry.buffers.push_back(buffer);
+    return buffer;
+  }
+
+  // Buffers stay registered after their thread exits, so its zones can still be exported
+  Buffer& getThreadBuffer()
+  {
+    thread_local std::shared_ptr<Buffer> buffer;
+    if (buffer == nullptr)
+    {
+      Registry& registry = getRegistry();
+      std::lock_guard<std::mutex> lock {registry.mutex};
+      buffer = createBuffer(registry);
+    }
+    return *buffer;
+  }
+
+  void push(Buffer& buffer, const char* name, const std::uint64_t start, const std::uint64_t end)
+  {
+    std::lock_guard<std::mutex> lock {buffer.mutex};
+    buffer.events[buffer.recorded % crb::Profiler::EVENT_CAPACITY] = {name, start, end};
+    buffer.recorded++;
+  }
+
+  void writeEscaped(std::ostream& stream, const std::string& text)
+  {
+    for (const char character : text)
+    {
+      if (character == '"' || character == '\\')
+      {
+        stream << '\\';
+      }
+      stream << character;
+    }
+  }
+
+  // Writes without going through floating point, keeping the nanosecond precision
+  void writeMicroseconds(std::ostream& stream, const std::uint64_t nanoseconds)
+  {
+    const std::uint64_t fraction = nanoseconds % 1000;
+    stream << nanoseconds / 1000 << '.' << (char)('0' + fraction / 100) << (char)('0' + fraction / 10 % 10) << (char)('0' + fraction % 10);
+  }
+
+  const std::chrono::steady_clock::time_point clockStart {std::chrono::steady_clock::now()};
+}
+
+std::uint64_t crb::Profiler::now()
+{
+  return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - clockStart).count();
+}
+
+void crb::Profiler::record(const char* name, const std::uint64_t start, const std::uint64_t end)
+{
+  push(getThreadBuffer(), name, start, end);
+}
+
+void crb::Profiler::recordTrack(const std::string& track, const char* name, const std::uint64_t start, const std::uint64_t end)
+{
+  std::shared_ptr<Buffer> buffer;
+  {
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock {registry.mutex};
+    std::shared_ptr<Buffer>& found = registry.tracks[track];
+    if (found == nullptr)
+    {
+      found = createBuffer(registry);
+      found->threadName = track;
+    }
+    buffer = found;
+  }
+  push(*buffer, name, start, end);
+}
+
+void crb::Profiler::setThreadName(const std::string& name)
+{
+  Buffer& buffer = getThreadBuffer();
+  std::lock_guard<std::mutex> lock {buffer.mutex};
+  buffer.threadName = name;
+}
+
+bool crb::Profiler::writeTrace(const std::string& path)
+{
+  std::ofstream file(path);
+  if (!file.is_open())
+  {
+    std::cerr << "Failed to write the profiler trace (" << path << ")!\n";
+    return false;
+  }
+
+  std::vector<std::shared_ptr<Buffer>> buffers;
+  {
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock {registry.mutex};
+    buffers = registry.buffers;
+  }
+
+  file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first {true};
+  std::vector<Event> events;
+  for (const std::shared_ptr<Buffer>& buffer : buffers)
+  {
+    std::string threadName;
+    std::uint32_t threadId;
+    {
+      std::lock_guard<std::mutex> lock {buffer->mutex};
+      const std::size_t count = std::min(buffer->recorded, EVENT_CAPACITY);
+      events.resize(count);
+      for (std::size_t i = 0; i < count; i++)
+      {
+        events[i] = buffer->events[(buffer->recorded - count + i) % EVENT_CAPACITY];
+      }
+      threadName = buffer->threadName.empty() ? "Thread " + std::to_string(buffer->threadId) : buffer->threadName;
+      threadId = buffer->threadId;
+    }
+
+    file << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId << ",\"args\":{\"name\":\"";
+    writeEscaped(file, threadName);
+    file << "\"}}";
+    first = false;
+
+    // Complete events, the trace format expects microseconds
+    for (const Event& event : events)
+    {
+      file << ",\n{\"name\":\"";
+      writeEscaped(file, event.name);
+      file << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadId << ",\"ts\":";
+      writeMicroseconds(file, event.start);
+      file << ",\"dur\":";
+      writeMicroseconds(file, event.end - event.start);
+      file << '}';
+    }
+  }
+  file << "\n]}\n";
+  return (bool)file;
+}
+
+void crb::Profiler::clear()
+{
+  Registry& registry = getRegistry();
+  std::lock_guard<std::mutex> lock {registry.mutex};
+  for (const std::shared_ptr<Buffer>& buffer : registry.buffers)
+  {
+    std::lock_guard<std::mutex> bufferLock {buffer->mutex};
+    buffer->recorded = 0;
+  }
+}
@@ -0,0 +1,185 @@
+#include "CRobes/RenderQueue.hpp"
+
+#include <algorithm>
+
+namespace
+{
+  // Bit layout of the sort keys
+  constexpr unsigned int PASS_SHIFT  {62u};
+  constexpr std::uint64_t DEPTH_MAX  {0xFFFFFFu};
+  constexpr std::uint64_t ID_MASK    {0x3FFu};
+  constexpr std::uint64_t VAO_MASK   {0xFFFFu};
+
+  // GPU timer scope names, indexed by pass
+  const char* const PASS_NAMES[] {"Opaque", "Transparent", "Overlay"};
+
+  void drawSolid(const void* object, const crb::Graphics::Shader& shader, GLenum mode)
+  {
+    ((const crb::Solids::Solid*)object)->render(shader, mode);
+  }
+
+  void drawElement(const void* object, const crb::Graphics::Shader& shader, GLenum)
+  {
+    ((const crb::GUI::Element*)object)->render(shader);
+  }
+}
+
+void crb::RenderQueue::begin(const crb::Space::Vec3& viewPosition, const float farPlane)
+{
+  this->items.clear();
+  this->viewPosition = viewPosition;
+  this->farPlane = farPlane > 0.f ? farPlane : 1.f;
+}
+
+void crb::RenderQueue::submit(const crb::Solids::Solid& solid, const crb::Graphics::Shader& shader, const crb::Graphics::Texture* texture, GLenum mode, const crb::RenderQueue::Pass pass)
+{
+  const crb::Space::AABB bounds = solid.getBounds();
+  const crb::Space::Vec3 center = (bounds.min + bounds.max) * 0.5f;
+
+  crb::RenderQueue::Item item;
+  item.object = &solid;
+  item.draw = drawSolid;
+  item.shader = &shader;
+  item.texture = texture;
+  item.vertexArray = solid.getVertexArrayID();
+  item.mode = mode;
+  item.pass = pass;
+  item.depth = crb::Space::lengthOf(center - this->viewPosition);
+  this->items.push_back(item);
+}
+
+void crb::RenderQueue::submit(const crb::GUI::Element& element, const crb::Graphics::Shader& shader, const crb::Graphics::Texture* texture)
+{
+  crb::RenderQueue::Item item;
+  item.object = &element;
+  item.draw = drawElement;
+  item.shader = &shader;
+  item.texture = texture;
+  item.vertexArray = element.getVertexArrayID();
+  item.pass = crb::RenderQueue::Overlay;
+  this->items.push_back(item);
+}
+
+std::size_t crb::RenderQueue::flush(crb::Graphics::GpuTimer* timer)
+{
+  this->entries.resize(this->items.size());
+  for (std::size_t i = 0; i < this->items.size(); i++)
+  {
+    this->entries[i] = {this->_makeKey(this->items[i]), (std::uint32_t)i};
+  }
+  this->_sort();
+
+  // The passes change the depth state, which is handed back as the caller left it
+  const GLboolean depthMask = crb::Graphics::State::getDepthMask();
+  const bool depthTest = crb::Graphics::State::isCapabilityEnabled(GL_DEPTH_TEST);
+
+  const crb::Graphics::Shader* shader {NULL};
+  const crb::Graphics::Texture* texture {NULL};
+  int pass {-1};
+  for (const Entry& entry : this->entries)
+  {
+    const crb::RenderQueue::Item& item = this->items[entry.index];
+    if (item.pass != pass)
+    {
+      if (timer != NULL)
+      {
+        if (pass != -1)
+        {
+          timer->end();
+        }
+        timer->begin(PASS_NAMES[item.pass]);
+      }
+      pass = item.pass;
+      crb::Graphics::State::setDepthMask(pass == crb::RenderQueue::Transparent ? GL_FALSE : GL_TRUE);
+      if (pass == crb::RenderQueue::Overlay)
+      {
+        crb::Graphics::State::setCapability(GL_DEPTH_TEST, false);
+      }
+    }
+    if (item.shader != shader)
+    {
+      shader = item.shader;
+      shader->Use();
+      texture = NULL;
+    }
+    if (item.texture != NULL && item.texture != texture)
+    {
+      texture = item.texture;
+      texture->Bind();
+      texture->ApplyUnit(*shader, 0);
+    }
+    item.draw(item.object, *shader, item.mode);
+  }
+
+  if (timer != NULL && pass != -1)
+  {
+    timer->end();
+  }
+
+  crb::Graphics::State::setDepthMask(depthMask);
+  crb::Graphics::State::setCapability(GL_DEPTH_TEST, depthTest);
+
+  const std::size_t drawn = this->items.size();
+  this->items.clear();
+  return drawn;
+}
+
+std::uint64_t crb::RenderQueue::_makeKey(const crb::RenderQueue::Item& item) const
+{
+  const float normalized = std::min(std::max(item.depth / this->farPlane, 0.f), 1.f);
+  const std::uint64_t depth = (std::uint64_t)(normalized * DEPTH_MAX);
+  const std::uint64_t shader = item.shader != NULL ? item.shader->getID() & ID_MASK : 0u;
+  const std::uint64_t texture = item.texture != NULL ? item.texture->getID() & ID_MASK : 0u;
+  const std::uint64_t vertexArray = item.vertexArray & VAO_MASK;
+
+  std::uint64_t key = (std::uint64_t)item.pass << PASS_SHIFT;
+  if (item.pass == crb::RenderQueue::Transparent)
+  {
+    // Back to front, state only breaks ties
+    key |= (DEPTH_MAX - depth) << 38;
+    key |= shader << 28;
+    key |= texture << 18;
+    key |= vertexArray << 2;
+  }
+  else
+  {
+    // Grouped by state, front to back within a group
+    key |= shader << 52;
+    key |= texture << 42;
+    key |= vertexArray << 26;
+    key |= depth << 2;
+  }
+  return key;
+}
+
+void crb::RenderQueue::_sort()
+{
+  this->scratch.resize(this->entries.size());
+
+  // One pass per byte, skipping bytes shared by every key
+  for (unsigned int shift = 0; shift < 64; shift += 8)
+  {
+    std::size_t counts[256] {};
+    for (const Entry& entry : this->entries)
+    {
+      counts[(entry.key >> shift) & 0xFF]++;
+    }
+    if (!this->entries.empty() && counts[(this->entries[0].key >> shift) & 0xFF] == this->entries.size())
+    {
+      continue;
+    }
+
+    std::size_t offset {0u};
+    for (std::size_t& count : counts)
+    {
+      const std::size_t bucketSize = count;
+      count = offset;
+      offset += bucketSize;
+    }
+    for (const Entry& entry : this->entries)
+    {
+      this->scratch[counts[(entry.key >> shift) & 0xFF]++] = entry;
+    }
+    this->entries.swap(this->scratch);
+  }
+}
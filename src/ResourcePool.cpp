@@ -0,0 +1,88 @@
+#include "CRobes/ResourcePool.hpp"
+
+#include <iostream>
+
+namespace
+{
+  // The pool of the current context, set by its window
+  crb::Graphics::MeshPool* currentMeshPool {NULL};
+
+  crb::Graphics::MeshHandle insertMesh(const crb::Graphics::MeshBuffers& buffers)
+  {
+    if (currentMeshPool == NULL)
+    {
+      std::cerr << "Created a mesh without a current mesh pool!\n";
+      crb::Graphics::MeshBuffers released {buffers};
+      crb::Graphics::deleteMeshBuffers(released);
+      return {};
+    }
+    return currentMeshPool->insert(buffers);
+  }
+}
+
+void crb::Graphics::setMeshPool(crb::Graphics::MeshPool* pool)
+{
+  currentMeshPool = pool;
+}
+
+void crb::Graphics::releaseMeshPool(crb::Graphics::MeshPool& pool)
+{
+  std::vector<crb::Graphics::MeshBuffers> leftovers;
+  pool.removeAll(leftovers);
+  for (crb::Graphics::MeshBuffers& buffers : leftovers)
+  {
+    crb::Graphics::deleteMeshBuffers(buffers);
+  }
+  if (currentMeshPool == &pool)
+  {
+    currentMeshPool = NULL;
+  }
+}
+
+crb::Graphics::MeshHandle crb::Graphics::createMesh(const crb::Graphics::VertexLayout& layout, const void* vertices, const GLsizeiptr verticesSize, const GLuint indices[], const GLsizeiptr indicesSize, crb::Graphics::DeletionQueue* deletionQueue)
+{
+  crb::Graphics::MeshBuffers buffers;
+  if (deletionQueue == NULL || !deletionQueue->reuse(layout, verticesSize, indicesSize, buffers))
+  {
+    buffers = crb::Graphics::createMeshBuffers(layout, verticesSize, indicesSize);
+  }
+  crb::Graphics::uploadMeshBuffers(buffers, vertices, verticesSize, indices, indicesSize);
+  return insertMesh(buffers);
+}
+
+crb::Graphics::MeshHandle crb::Graphics::createMesh(const crb::Graphics::VertexLayout& layout, const GLsizeiptr verticesSize, const GLsizeiptr indicesSize, const GLenum usage)
+{
+  return insertMesh(crb::Graphics::createMeshBuffers(layout, verticesSize, indicesSize, usage));
+}
+
+const crb::Graphics::MeshBuffers* crb::Graphics::getMesh(const crb::Graphics::MeshHandle handle)
+{
+  return currentMeshPool != NULL ? currentMeshPool->get(handle) : NULL;
+}
+
+bool crb::Graphics::retainMesh(const crb::Graphics::MeshHandle handle)
+{
+  return currentMeshPool != NULL && currentMeshPool->retain(handle);
+}
+
+void crb::Graphics::destroyMesh(const crb::Graphics::MeshHandle handle, crb::Graphics::DeletionQueue* deletionQueue)
+{
+  crb::Graphics::MeshBuffers buffers;
+  if (currentMeshPool == NULL || !currentMeshPool->release(handle, buffers))
+  {
+    return;
+  }
+  if (deletionQueue != NULL)
+  {
+    deletionQueue->recycle(buffers);
+  }
+  else
+  {
+    crb::Graphics::deleteMeshBuffers(buffers);
+  }
+}
+
+std::size_t crb::Graphics::getMeshCount()
+{
+  return currentMeshPool != NULL ? currentMeshPool->getSize() : 0u;
+}
@@ -1,77 +1,165 @@
 #include "CRobes/Solids.hpp"
+#include "CRobes/MeshBuilder.hpp"
 
-crb::Solids::Solid::Solid(const crb::Space::Vec3& position, GLfloat vertices[], GLsizeiptr verticesSize, GLuint indices[], GLsizeiptr indicesSize)
-: position(position), vertexCount(indicesSize / sizeof(GLuint))
-{
-  this->VAO = new crb::Graphics::VAO();
-  this->VBO = new crb::Graphics::VBO(vertices, verticesSize);
-  this->EBO = new crb::Graphics::EBO(indices, indicesSize);
-
-  this->VAO->Bind();
-  this->VBO->Bind();
-  this->EBO->Bind();
+#include <algorithm>
+#include <cstring>
 
-  this->VAO->LinkAttribute(*this->VBO, 0, 3, GL_FLOAT, 8 * sizeof(GLfloat), (void*)0);
-  this->VAO->LinkAttribute(*this->VBO, 1, 3, GL_FLOAT, 8 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat)));
-  this->VAO->LinkAttribute(*this->VBO, 2, 2, GL_FLOAT, 8 * sizeof(GLfloat), (void*)(6 * sizeof(GLfloat)));
+crb::Space::AABB crb::Solids::computeBounds(const GLfloat vertices[], std::size_t floatCount)
+{
+  crb::Space::AABB bounds;
+  if (floatCount >= 3)
+  {
+    bounds.min = {vertices[0], vertices[1], vertices[2]};
+    bounds.max = bounds.min;
+  }
+  for (std::size_t i = crb::Solids::VERTEX_FLOATS; i + 2 < floatCount; i += crb::Solids::VERTEX_FLOATS)
+  {
+    bounds.min = {std::min(bounds.min.x, vertices[i]), std::min(bounds.min.y, vertices[i + 1]), std::min(bounds.min.z, vertices[i + 2])};
+    bounds.max = {std::max(bounds.max.x, vertices[i]), std::max(bounds.max.y, vertices[i + 1]), std::max(bounds.max.z, vertices[i + 2])};
+  }
+  return bounds;
+}
 
-  this->VAO->Unbind();
-  this->VBO->Unbind();
-  this->EBO->Unbind();
+void crb::Solids::translate(crb::Solids::Mesh& mesh, const crb::Space::Vec3& offset)
+{
+  for (std::size_t i = 0; i + 2 < mesh.vertices.size(); i += crb::Solids::VERTEX_FLOATS)
+  {
+    mesh.vertices[i]     += offset.x;
+    mesh.vertices[i + 1] += offset.y;
+    mesh.vertices[i + 2] += offset.z;
+  }
 }
 
+crb::Solids::Solid::Solid(const crb::Space::Vec3& position, const GLfloat vertices[], GLsizeiptr verticesSize, const GLuint indices[], GLsizeiptr indicesSize, crb::Graphics::DeletionQueue* deletionQueue)
+: position(position),
+  bounds(crb::Solids::computeBounds(vertices, verticesSize / sizeof(GLfloat))),
+  mesh(crb::Graphics::createMesh(crb::Solids::VertexFormat::LAYOUT, vertices, verticesSize, indices, indicesSize, deletionQueue)),
+  deletionQueue(deletionQueue),
+  vertexCount(indicesSize / sizeof(GLuint))
+{}
+
 void crb::Solids::Solid::render(const crb::Graphics::Shader& shader, GLenum mode) const
 {
-  crb::Space::Mat4 appliedMatrix {this->model};
-  appliedMatrix = crb::Space::translate(appliedMatrix, this->position);
-  shader.SetMatrix4(appliedMatrix, "model");
-  this->VAO->Bind();
+  CRB_PROFILE_SCOPE("Solid::render");
+  const crb::Graphics::MeshBuffers* buffers = crb::Graphics::getMesh(this->mesh);
+  if (buffers == NULL)
+  {
+    return;
+  }
+  shader.SetMatrix4(crb::Space::translate(crb::Space::Mat4(1.f), this->position), "model");
+  crb::Graphics::State::bindVertexArray(buffers->vertexArray);
   glDrawElements(mode, this->vertexCount, GL_UNSIGNED_INT, NULL);
-  this->VAO->Unbind();
 }
 
-crb::Solids::Solid crb::Solids::SolidFactory::createPlane(const crb::Space::Vec3& position, const float length, const float width, const unsigned int segmentCount)
+crb::Solids::InstancedSolid::InstancedSolid(const crb::Solids::Mesh& mesh)
+: mesh(crb::Graphics::createMesh(
+    crb::Solids::VertexFormat::LAYOUT,
+    mesh.vertices.data(),
+    (GLsizeiptr)(mesh.vertices.size() * sizeof(GLfloat)),
+    mesh.indices.data(),
+    (GLsizeiptr)(mesh.indices.size() * sizeof(GLuint))
+  )),
+  instanceBuffer(GL_ARRAY_BUFFER, (GLsizeiptr)(INSTANCE_CAPACITY * sizeof(crb::Space::Vec3))),
+  bounds(crb::Solids::computeBounds(mesh.vertices.data(), mesh.vertices.size())),
+  vertexCount(mesh.indices.size())
+{
+  // Only this vertex array reads the offsets, so its buffers are never handed to a deletion queue for reuse
+  const GLuint vertexArray = this->getVertexArrayID();
+  crb::Graphics::State::bindVertexArray(vertexArray);
+  glEnableVertexAttribArray(OFFSET_LAYOUT);
+  glVertexAttribDivisor(OFFSET_LAYOUT, 1);
+  crb::Graphics::State::bindVertexArray(0);
+}
+
+void crb::Solids::InstancedSolid::setInstances(const std::vector<crb::Space::Vec3>& offsets)
 {
-  GLfloat vertices[(segmentCount + 1) * (segmentCount + 1) * 8];
-  GLuint indices[(segmentCount * 2 + 3) * segmentCount];
+  static_assert(sizeof(crb::Space::Vec3) == 3 * sizeof(GLfloat), "Vec3 must be tightly packed");
 
-  for (int z = 0; z < segmentCount + 1; z++)
+  this->instanceBuffer.nextFrame();
+  this->instanceCount = 0;
+  if (offsets.empty())
   {
-    for (int x = 0; x < segmentCount + 1; x++)
+    return;
+  }
+
+  const GLsizeiptr size = (GLsizeiptr)(offsets.size() * sizeof(crb::Space::Vec3));
+  GLintptr offset {0};
+  void* data = this->instanceBuffer.map(size, (GLsizeiptr)sizeof(crb::Space::Vec3), offset);
+  if (data == NULL)
+  {
+    return;
+  }
+  std::memcpy(data, offsets.data(), size);
+  this->instanceBuffer.unmap();
+  this->instanceCount = (GLsizei)offsets.size();
+
+  // The offsets move to another region of the ring every frame
+  crb::Graphics::State::bindVertexArray(this->getVertexArrayID());
+  this->instanceBuffer.Bind();
+  glVertexAttribPointer(OFFSET_LAYOUT, 3, GL_FLOAT, GL_FALSE, sizeof(crb::Space::Vec3), (const void*)offset);
+  crb::Graphics::State::bindVertexArray(0);
+  this->instanceBuffer.Unbind();
+}
+
+void crb::Solids::InstancedSolid::render(const crb::Graphics::Shader& shader, GLenum mode) const
+{
+  if (this->instanceCount == 0)
+  {
+    return;
+  }
+  const crb::Graphics::MeshBuffers* buffers = crb::Graphics::getMesh(this->mesh);
+  if (buffers == NULL)
+  {
+    return;
+  }
+  shader.SetMatrix4(crb::Space::Mat4(1.f), "model");
+  crb::Graphics::State::bindVertexArray(buffers->vertexArray);
+  glDrawElementsInstanced(mode, this->vertexCount, GL_UNSIGNED_INT, NULL, this->instanceCount);
+}
+
+std::size_t crb::Solids::cull(const std::vector<crb::Solids::Solid>& solids, const crb::Space::Frustum& frustum, std::vector<const crb::Solids::Solid*>& oVisible)
+{
+  oVisible.clear();
+  for (const crb::Solids::Solid& solid : solids)
+  {
+    if (solid.isVisible(frustum))
     {
-      int index = z * (segmentCount + 1) * 8 + x * 8;
-      vertices[index]     = x * length / segmentCount;
-      vertices[index + 1] = 0.f;
-      vertices[index + 2] = z * width / segmentCount;
-      vertices[index + 3] = 0.f;
-      vertices[index + 4] = 0.f;
-      vertices[index + 5] = 0.f;
-      vertices[index + 6] = (float)x;
-      vertices[index + 7] = (float)z;
+      oVisible.push_back(&solid);
     }
   }
+  return solids.size() - oVisible.size();
+}
 
-  for (int i = 0; i < segmentCount; i++)
+crb::Solids::Mesh crb::Solids::SolidFactory::generatePlane(const float length, const float width, const unsigned int segmentCount) const
+{
+  const GLuint rowVertexCount = segmentCount + 1;
+
+  crb::Solids::MeshBuilder builder;
+  builder.begin((std::size_t)rowVertexCount * rowVertexCount, ((std::size_t)rowVertexCount * 2 + 1) * segmentCount);
+
+  for (GLuint z = 0; z < rowVertexCount; z++)
   {
-    for (int j = 0; j <= segmentCount * 2 + 2; j++)
+    for (GLuint x = 0; x < rowVertexCount; x++)
     {
-      if (j == segmentCount * 2 + 2)
-      {
-        indices[i * (segmentCount * 2 + 2) + j + i] = 65535;
-        continue;
-      }
-      indices[i * (segmentCount * 2 + 2) + j + i] =
-        i * (segmentCount + 1)
-        + (j % 2 == 0 ? j : j + segmentCount)
-        - j / 2;
+      builder.addVertex({x * length / segmentCount, 0.f, z * width / segmentCount}, (float)x, (float)z);
     }
   }
 
-  return crb::Solids::Solid(
-    position,
-    vertices,
-    sizeof(vertices),
-    indices,
-    sizeof(indices)
-  );
+  // One triangle strip per row, zigzagging between its two edges
+  for (GLuint z = 0; z < segmentCount; z++)
+  {
+    for (GLuint x = 0; x < rowVertexCount; x++)
+    {
+      builder.addIndex(z * rowVertexCount + x);
+      builder.addIndex((z + 1) * rowVertexCount + x);
+    }
+    builder.restartPrimitive();
+  }
+
+  return builder.finish();
+}
+
+crb::Solids::Solid crb::Solids::SolidFactory::createPlane(const crb::Space::Vec3& position, const float length, const float width, const unsigned int segmentCount)
+{
+  return crb::Solids::Solid(position, this->generatePlane(length, width, segmentCount));
 }
@@ -1,6 +1,10 @@
 #include "CRobes/Constants.hpp"
 #include "CRobes/Space.hpp"
 
+#if defined(CRB_SIMD_SSE)
+  #include <immintrin.h>
+#endif
+
 crb::Space::Mat4 crb::Space::ortho(const float left, const float right, const float top, const float bottom, const float zNear, const float zFar)
 {
   crb::Space::Mat4 result {1.f};
@@ -50,3 +54,379 @@ crb::Space::Mat4 crb::Space::lookAt(const crb::Space::Vec3& eye, const crb::Spac
 
   return result;
 }
+
+bool crb::Space::Frustum::intersects(const crb::Space::AABB& box) const
+{
+  for (const crb::Space::Plane& plane : this->planes)
+  {
+    // Corner of the box furthest along the plane normal
+    const crb::Space::Vec3 corner {
+      plane.normal.x >= 0.f ? box.max.x : box.min.x,
+      plane.normal.y >= 0.f ? box.max.y : box.min.y,
+      plane.normal.z >= 0.f ? box.max.z : box.min.z,
+    };
+    if (crb::Space::dot(plane.normal, corner) + plane.distance < 0.f)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+crb::Space::Frustum crb::Space::extractFrustum(const crb::Space::Mat4& mat)
+{
+  // Row i of the clip-space transform is column i of the stored matrix
+  const auto combine = [&](const int row, const float sign)
+  {
+    crb::Space::Plane plane;
+    plane.normal = {
+      mat[0][3] + sign * mat[0][row],
+      mat[1][3] + sign * mat[1][row],
+      mat[2][3] + sign * mat[2][row],
+    };
+    plane.distance = mat[3][3] + sign * mat[3][row];
+
+    const float length = crb::Space::lengthOf(plane.normal);
+    if (length > 0.f)
+    {
+      plane.normal *= 1.f / length;
+      plane.distance /= length;
+    }
+    return plane;
+  };
+
+  crb::Space::Frustum frustum;
+  frustum.setPlane(crb::Space::Frustum::Left,   combine(0,  1.f));
+  frustum.setPlane(crb::Space::Frustum::Right,  combine(0, -1.f));
+  frustum.setPlane(crb::Space::Frustum::Bottom, combine(1,  1.f));
+  frustum.setPlane(crb::Space::Frustum::Top,    combine(1, -1.f));
+  frustum.setPlane(crb::Space::Frustum::Near,   combine(2,  1.f));
+  frustum.setPlane(crb::Space::Frustum::Far,    combine(2, -1.f));
+  return frustum;
+}
+
+crb::Space::Mat4 crb::Space::Mat4::operator*(const crb::Space::Mat4& mat)
+{
+  return crb::Space::multiply(*this, mat);
+}
+
+crb::Space::Vec4 crb::Space::Mat4::operator*(const crb::Space::Vec4& vec)
+{
+  return crb::Space::transform(*this, vec);
+}
+
+crb::Space::Mat4 crb::Space::Scalar::multiply(const crb::Space::Mat4& matOne, const crb::Space::Mat4& matTwo)
+{
+  crb::Space::Mat4 result;
+  for (int i = 0; i < 4; i++)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      result[i][j] = 0.f;
+      for (int k = 0; k < 4; k++)
+      {
+        result[i][j] += matOne[i][k] * matTwo[k][j];
+      }
+    }
+  }
+  return result;
+}
+
+crb::Space::Vec4 crb::Space::Scalar::transform(const crb::Space::Mat4& mat, const crb::Space::Vec4& vec)
+{
+  return
+  {
+    vec.x * mat[0][0] + vec.y * mat[1][0] + vec.z * mat[2][0] + vec.w * mat[3][0],
+    vec.x * mat[0][1] + vec.y * mat[1][1] + vec.z * mat[2][1] + vec.w * mat[3][1],
+    vec.x * mat[0][2] + vec.y * mat[1][2] + vec.z * mat[2][2] + vec.w * mat[3][2],
+    vec.x * mat[0][3] + vec.y * mat[1][3] + vec.z * mat[2][3] + vec.w * mat[3][3],
+  };
+}
+
+crb::Space::Mat4 crb::Space::Scalar::affineInverse(const crb::Space::Mat4& mat)
+{
+  // Cofactors of the 3x3 linear part
+  const float c00 = mat[1][1] * mat[2][2] - mat[1][2] * mat[2][1];
+  const float c01 = mat[1][2] * mat[2][0] - mat[1][0] * mat[2][2];
+  const float c02 = mat[1][0] * mat[2][1] - mat[1][1] * mat[2][0];
+
+  const float determinant = mat[0][0] * c00 + mat[0][1] * c01 + mat[0][2] * c02;
+  if (determinant == 0.f)
+  {
+    return crb::Space::Mat4();
+  }
+  const float inverseDeterminant = 1.f / determinant;
+
+  crb::Space::Mat4 result {1.f};
+  result[0][0] = c00 * inverseDeterminant;
+  result[1][0] = c01 * inverseDeterminant;
+  result[2][0] = c02 * inverseDeterminant;
+  result[0][1] = (mat[0][2] * mat[2][1] - mat[0][1] * mat[2][2]) * inverseDeterminant;
+  result[1][1] = (mat[0][0] * mat[2][2] - mat[0][2] * mat[2][0]) * inverseDeterminant;
+  result[2][1] = (mat[0][1] * mat[2][0] - mat[0][0] * mat[2][1]) * inverseDeterminant;
+  result[0][2] = (mat[0][1] * mat[1][2] - mat[0][2] * mat[1][1]) * inverseDeterminant;
+  result[1][2] = (mat[0][2] * mat[1][0] - mat[0][0] * mat[1][2]) * inverseDeterminant;
+  result[2][2] = (mat[0][0] * mat[1][1] - mat[0][1] * mat[1][0]) * inverseDeterminant;
+
+  // Inverted Translation
+  for (int x = 0; x < 3; x++)
+  {
+    result[3][x] = -(mat[3][0] * result[0][x] + mat[3][1] * result[1][x] + mat[3][2] * result[2][x]);
+  }
+  return result;
+}
+
+crb::Space::Mat4 crb::Space::Scalar::inverse(const crb::Space::Mat4& mat)
+{
+  const float* m = crb::Space::valuePointer(mat);
+  float inv[16];
+
+  inv[0]  =  m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+  inv[4]  = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+  inv[8]  =  m[4] * m[9]  * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+  inv[12] = -m[4] * m[9]  * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+  inv[1]  = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+  inv[5]  =  m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+  inv[9]  = -m[0] * m[9]  * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+  inv[13] =  m[0] * m[9]  * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+  inv[2]  =  m[1] * m[6]  * m[15] - m[1] * m[7]  * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7]  - m[13] * m[3] * m[6];
+  inv[6]  = -m[0] * m[6]  * m[15] + m[0] * m[7]  * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7]  + m[12] * m[3] * m[6];
+  inv[10] =  m[0] * m[5]  * m[15] - m[0] * m[7]  * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7]  - m[12] * m[3] * m[5];
+  inv[14] = -m[0] * m[5]  * m[14] + m[0] * m[6]  * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6]  + m[12] * m[2] * m[5];
+  inv[3]  = -m[1] * m[6]  * m[11] + m[1] * m[7]  * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9]  * m[2] * m[7]  + m[9]  * m[3] * m[6];
+  inv[7]  =  m[0] * m[6]  * m[11] - m[0] * m[7]  * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8]  * m[2] * m[7]  - m[8]  * m[3] * m[6];
+  inv[11] = -m[0] * m[5]  * m[11] + m[0] * m[7]  * m[9]  + m[4] * m[1] * m[11] - m[4] * m[3] * m[9]  - m[8]  * m[1] * m[7]  + m[8]  * m[3] * m[5];
+  inv[15] =  m[0] * m[5]  * m[10] - m[0] * m[6]  * m[9]  - m[4] * m[1] * m[10] + m[4] * m[2] * m[9]  + m[8]  * m[1] * m[6]  - m[8]  * m[2] * m[5];
+
+  const float determinant = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+  if (determinant == 0.f)
+  {
+    return crb::Space::Mat4();
+  }
+  const float inverseDeterminant = 1.f / determinant;
+
+  crb::Space::Mat4 result;
+  for (int y = 0; y < 4; y++)
+  {
+    for (int x = 0; x < 4; x++)
+    {
+      result[y][x] = inv[y * 4 + x] * inverseDeterminant;
+    }
+  }
+  return result;
+}
+
+#if defined(CRB_SIMD_SSE)
+
+// Shuffle Helpers
+#define CRB_SHUFFLE(vecOne, vecTwo, x, y, z, w) _mm_shuffle_ps(vecOne, vecTwo, _MM_SHUFFLE(w, z, y, x))
+#define CRB_SWIZZLE(vec, x, y, z, w)            _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(w, z, y, x))
+
+namespace
+{
+  // 2x2 row-major matrix product A * B
+  inline __m128 mat2Multiply(const __m128 matOne, const __m128 matTwo)
+  {
+    return _mm_add_ps(
+      _mm_mul_ps(matOne, CRB_SWIZZLE(matTwo, 0, 3, 0, 3)),
+      _mm_mul_ps(CRB_SWIZZLE(matOne, 1, 0, 3, 2), CRB_SWIZZLE(matTwo, 2, 1, 2, 1))
+    );
+  }
+
+  // 2x2 row-major adjugate product adj(A) * B
+  inline __m128 mat2AdjugateMultiply(const __m128 matOne, const __m128 matTwo)
+  {
+    return _mm_sub_ps(
+      _mm_mul_ps(CRB_SWIZZLE(matOne, 3, 3, 0, 0), matTwo),
+      _mm_mul_ps(CRB_SWIZZLE(matOne, 1, 1, 2, 2), CRB_SWIZZLE(matTwo, 2, 3, 0, 1))
+    );
+  }
+
+  // 2x2 row-major product with adjugate A * adj(B)
+  inline __m128 mat2MultiplyAdjugate(const __m128 matOne, const __m128 matTwo)
+  {
+    return _mm_sub_ps(
+      _mm_mul_ps(matOne, CRB_SWIZZLE(matTwo, 3, 0, 3, 0)),
+      _mm_mul_ps(CRB_SWIZZLE(matOne, 1, 0, 3, 2), CRB_SWIZZLE(matTwo, 2, 1, 2, 1))
+    );
+  }
+
+  // Cross product of the xyz lanes, leaving w at zero
+  inline __m128 cross3(const __m128 vecOne, const __m128 vecTwo)
+  {
+    return _mm_sub_ps(
+      _mm_mul_ps(CRB_SWIZZLE(vecOne, 1, 2, 0, 3), CRB_SWIZZLE(vecTwo, 2, 0, 1, 3)),
+      _mm_mul_ps(CRB_SWIZZLE(vecOne, 2, 0, 1, 3), CRB_SWIZZLE(vecTwo, 1, 2, 0, 3))
+    );
+  }
+}
+
+crb::Space::Mat4 crb::Space::multiply(const crb::Space::Mat4& matOne, const crb::Space::Mat4& matTwo)
+{
+  crb::Space::Mat4 result;
+
+#if defined(CRB_SIMD_AVX)
+  // Both lanes hold the same row of the right-hand matrix
+  const __m256 row0 = _mm256_broadcast_ps((const __m128*)matTwo[0]);
+  const __m256 row1 = _mm256_broadcast_ps((const __m128*)matTwo[1]);
+  const __m256 row2 = _mm256_broadcast_ps((const __m128*)matTwo[2]);
+  const __m256 row3 = _mm256_broadcast_ps((const __m128*)matTwo[3]);
+
+  // Two rows of the left-hand matrix per iteration
+  for (int i = 0; i < 4; i += 2)
+  {
+    const __m256 rows = _mm256_loadu_ps(matOne[i]);
+    __m256 sum = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x00), row0);
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x55), row1));
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xAA), row2));
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xFF), row3));
+    _mm256_storeu_ps(result[i], sum);
+  }
+#else
+  const __m128 row0 = _mm_load_ps(matTwo[0]);
+  const __m128 row1 = _mm_load_ps(matTwo[1]);
+  const __m128 row2 = _mm_load_ps(matTwo[2]);
+  const __m128 row3 = _mm_load_ps(matTwo[3]);
+
+  for (int i = 0; i < 4; i++)
+  {
+    __m128 sum = _mm_mul_ps(_mm_set1_ps(matOne[i][0]), row0);
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(matOne[i][1]), row1));
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(matOne[i][2]), row2));
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(matOne[i][3]), row3));
+    _mm_store_ps(result[i], sum);
+  }
+#endif
+
+  return result;
+}
+
+crb::Space::Vec4 crb::Space::transform(const crb::Space::Mat4& mat, const crb::Space::Vec4& vec)
+{
+  __m128 sum = _mm_mul_ps(_mm_set1_ps(vec.x), _mm_load_ps(mat[0]));
+  sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(vec.y), _mm_load_ps(mat[1])));
+  sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(vec.z), _mm_load_ps(mat[2])));
+  sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(vec.w), _mm_load_ps(mat[3])));
+
+  crb::Space::Vec4 result;
+  _mm_store_ps(&result.x, sum);
+  return result;
+}
+
+crb::Space::Mat4 crb::Space::affineInverse(const crb::Space::Mat4& mat)
+{
+  const __m128 row0 = _mm_load_ps(mat[0]);
+  const __m128 row1 = _mm_load_ps(mat[1]);
+  const __m128 row2 = _mm_load_ps(mat[2]);
+  const __m128 translation = _mm_load_ps(mat[3]);
+
+  // Columns of the adjugate of the linear part
+  __m128 column0 = cross3(row1, row2);
+  __m128 column1 = cross3(row2, row0);
+  __m128 column2 = cross3(row0, row1);
+  __m128 column3 = _mm_setzero_ps();
+
+  __m128 determinant = _mm_mul_ps(row0, column0);
+  determinant = _mm_add_ss(_mm_add_ss(determinant, CRB_SWIZZLE(determinant, 1, 1, 1, 1)), CRB_SWIZZLE(determinant, 2, 2, 2, 2));
+  if (_mm_cvtss_f32(determinant) == 0.f)
+  {
+    return crb::Space::Mat4();
+  }
+  const __m128 inverseDeterminant = _mm_div_ps(_mm_set1_ps(1.f), CRB_SWIZZLE(determinant, 0, 0, 0, 0));
+
+  column0 = _mm_mul_ps(column0, inverseDeterminant);
+  column1 = _mm_mul_ps(column1, inverseDeterminant);
+  column2 = _mm_mul_ps(column2, inverseDeterminant);
+  _MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+
+  // Inverted Translation
+  __m128 inverseTranslation = _mm_mul_ps(CRB_SWIZZLE(translation, 0, 0, 0, 0), column0);
+  inverseTranslation = _mm_add_ps(inverseTranslation, _mm_mul_ps(CRB_SWIZZLE(translation, 1, 1, 1, 1), column1));
+  inverseTranslation = _mm_add_ps(inverseTranslation, _mm_mul_ps(CRB_SWIZZLE(translation, 2, 2, 2, 2), column2));
+  inverseTranslation = _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), inverseTranslation);
+
+  crb::Space::Mat4 result;
+  _mm_store_ps(result[0], column0);
+  _mm_store_ps(result[1], column1);
+  _mm_store_ps(result[2], column2);
+  _mm_store_ps(result[3], inverseTranslation);
+  return result;
+}
+
+crb::Space::Mat4 crb::Space::inverse(const crb::Space::Mat4& mat)
+{
+  const __m128 row0 = _mm_load_ps(mat[0]);
+  const __m128 row1 = _mm_load_ps(mat[1]);
+  const __m128 row2 = _mm_load_ps(mat[2]);
+  const __m128 row3 = _mm_load_ps(mat[3]);
+
+  // 2x2 Sub-Matrices
+  const __m128 A = _mm_movelh_ps(row0, row1);
+  const __m128 B = _mm_movehl_ps(row1, row0);
+  const __m128 C = _mm_movelh_ps(row2, row3);
+  const __m128 D = _mm_movehl_ps(row3, row2);
+
+  // Sub-Matrix Determinants (|A|, |B|, |C|, |D|)
+  const __m128 subDeterminants = _mm_sub_ps(
+    _mm_mul_ps(CRB_SHUFFLE(row0, row2, 0, 2, 0, 2), CRB_SHUFFLE(row1, row3, 1, 3, 1, 3)),
+    _mm_mul_ps(CRB_SHUFFLE(row0, row2, 1, 3, 1, 3), CRB_SHUFFLE(row1, row3, 0, 2, 0, 2))
+  );
+  const __m128 detA = CRB_SWIZZLE(subDeterminants, 0, 0, 0, 0);
+  const __m128 detB = CRB_SWIZZLE(subDeterminants, 1, 1, 1, 1);
+  const __m128 detC = CRB_SWIZZLE(subDeterminants, 2, 2, 2, 2);
+  const __m128 detD = CRB_SWIZZLE(subDeterminants, 3, 3, 3, 3);
+
+  const __m128 adjDC = mat2AdjugateMultiply(D, C);
+  const __m128 adjAB = mat2AdjugateMultiply(A, B);
+
+  // Adjugates of the result blocks
+  __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), mat2Multiply(B, adjDC));
+  __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), mat2Multiply(C, adjAB));
+  __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), mat2MultiplyAdjugate(D, adjAB));
+  __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), mat2MultiplyAdjugate(A, adjDC));
+
+  // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+  __m128 trace = _mm_mul_ps(adjAB, CRB_SWIZZLE(adjDC, 0, 2, 1, 3));
+  trace = _mm_add_ps(trace, _mm_movehl_ps(trace, trace));
+  trace = _mm_add_ss(trace, CRB_SWIZZLE(trace, 1, 1, 1, 1));
+
+  __m128 determinant = _mm_add_ss(_mm_mul_ss(detA, detD), _mm_mul_ss(detB, detC));
+  determinant = _mm_sub_ss(determinant, trace);
+  if (_mm_cvtss_f32(determinant) == 0.f)
+  {
+    return crb::Space::Mat4();
+  }
+  const __m128 inverseDeterminant = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), CRB_SWIZZLE(determinant, 0, 0, 0, 0));
+
+  X = _mm_mul_ps(X, inverseDeterminant);
+  Y = _mm_mul_ps(Y, inverseDeterminant);
+  Z = _mm_mul_ps(Z, inverseDeterminant);
+  W = _mm_mul_ps(W, inverseDeterminant);
+
+  // Applying the adjugate shuffle while storing
+  crb::Space::Mat4 result;
+  _mm_store_ps(result[0], CRB_SHUFFLE(X, Y, 3, 1, 3, 1));
+  _mm_store_ps(result[1], CRB_SHUFFLE(X, Y, 2, 0, 2, 0));
+  _mm_store_ps(result[2], CRB_SHUFFLE(Z, W, 3, 1, 3, 1));
+  _mm_store_ps(result[3], CRB_SHUFFLE(Z, W, 2, 0, 2, 0));
+  return result;
+}
+
+#undef CRB_SHUFFLE
+#undef CRB_SWIZZLE
+
+#else
+
+crb::Space::Mat4 crb::Space::multiply(const crb::Space::Mat4& matOne, const crb::Space::Mat4& matTwo)
+{ return crb::Space::Scalar::multiply(matOne, matTwo); }
+
+crb::Space::Vec4 crb::Space::transform(const crb::Space::Mat4& mat, const crb::Space::Vec4& vec)
+{ return crb::Space::Scalar::transform(mat, vec); }
+
+crb::Space::Mat4 crb::Space::affineInverse(const crb::Space::Mat4& mat)
+{ return crb::Space::Scalar::affineInverse(mat); }
+
+crb::Space::Mat4 crb::Space::inverse(const crb::Space::Mat4& mat)
+{ return crb::Space::Scalar::inverse(mat); }
+
+#endif
@@ -0,0 +1,250 @@
+#include "CRobes/State.hpp"
+
+namespace
+{
+  using Shadow = crb::Graphics::State::Cache;
+
+  constexpr GLuint UNKNOWN {Shadow::UNKNOWN};
+
+  // Set by the window whose context is current
+  Shadow* currentShadow {NULL};
+
+  Shadow& getShadow()
+  {
+    // Used until a window sets its own, e.g. by code running before any window exists
+    static Shadow fallback;
+    return currentShadow != NULL ? *currentShadow : fallback;
+  }
+
+  // Updates a shadowed value and tells whether the OpenGL call is needed
+  bool change(GLuint& current, const GLuint value)
+  {
+    Shadow& shadow = getShadow();
+    if (current == value)
+    {
+      shadow.savedCalls++;
+      return false;
+    }
+    current = value;
+    shadow.issuedCalls++;
+    return true;
+  }
+}
+
+void crb::Graphics::State::setCache(crb::Graphics::State::Cache* cache)
+{
+  currentShadow = cache;
+}
+
+void crb::Graphics::State::useProgram(GLuint program)
+{
+  if (change(getShadow().program, program))
+  {
+    glUseProgram(program);
+  }
+}
+
+void crb::Graphics::State::bindVertexArray(GLuint vertexArray)
+{
+  if (change(getShadow().vertexArray, vertexArray))
+  {
+    glBindVertexArray(vertexArray);
+  }
+}
+
+void crb::Graphics::State::bindBuffer(GLenum target, GLuint buffer)
+{
+  Shadow& shadow = getShadow();
+  GLuint* current {NULL};
+  if (target == GL_ELEMENT_ARRAY_BUFFER)
+  {
+    // Without a known vertex array object, the element array binding is unknown too
+    if (shadow.vertexArray == UNKNOWN)
+    {
+      shadow.issuedCalls++;
+      glBindBuffer(target, buffer);
+      return;
+    }
+    current = &shadow.elementBuffers.try_emplace(shadow.vertexArray, UNKNOWN).first->second;
+  }
+  else
+  {
+    current = &shadow.buffers.try_emplace(target, UNKNOWN).first->second;
+  }
+
+  if (change(*current, buffer))
+  {
+    glBindBuffer(target, buffer);
+  }
+}
+
+void crb::Graphics::State::bindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+  Shadow& shadow = getShadow();
+  shadow.issuedCalls++;
+  shadow.buffers[target] = buffer;
+  glBindBufferBase(target, index, buffer);
+}
+
+void crb::Graphics::State::setActiveTextureUnit(GLuint unit)
+{
+  if (change(getShadow().activeTextureUnit, unit))
+  {
+    glActiveTexture(GL_TEXTURE0 + unit);
+  }
+}
+
+void crb::Graphics::State::bindTexture(GLenum target, GLuint texture)
+{
+  Shadow& shadow = getShadow();
+  if (shadow.activeTextureUnit == UNKNOWN)
+  {
+    shadow.issuedCalls++;
+    glBindTexture(target, texture);
+    return;
+  }
+
+  const std::uint64_t key = ((std::uint64_t)shadow.activeTextureUnit << 32) | target;
+  if (change(shadow.textures.try_emplace(key, UNKNOWN).first->second, texture))
+  {
+    glBindTexture(target, texture);
+  }
+}
+
+void crb::Graphics::State::setPolygonMode(GLenum mode)
+{
+  if (change(getShadow().polygonMode, mode))
+  {
+    glPolygonMode(GL_FRONT_AND_BACK, mode);
+  }
+}
+
+void crb::Graphics::State::setDepthMask(GLboolean enabled)
+{
+  if (change(getShadow().depthMask, enabled))
+  {
+    glDepthMask(enabled);
+  }
+}
+
+void crb::Graphics::State::setCapability(GLenum capability, bool enabled)
+{
+  if (!change(getShadow().capabilities.try_emplace(capability, UNKNOWN).first->second, enabled))
+  {
+    return;
+  }
+  if (enabled)
+  {
+    glEnable(capability);
+  }
+  else
+  {
+    glDisable(capability);
+  }
+}
+
+GLboolean crb::Graphics::State::getDepthMask()
+{
+  Shadow& shadow = getShadow();
+  if (shadow.depthMask == UNKNOWN)
+  {
+    GLboolean enabled {GL_TRUE};
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &enabled);
+    shadow.depthMask = enabled;
+  }
+  return (GLboolean)shadow.depthMask;
+}
+
+bool crb::Graphics::State::isCapabilityEnabled(GLenum capability)
+{
+  GLuint& current = getShadow().capabilities.try_emplace(capability, UNKNOWN).first->second;
+  if (current == UNKNOWN)
+  {
+    current = glIsEnabled(capability);
+  }
+  return current == GL_TRUE;
+}
+
+void crb::Graphics::State::forgetProgram(GLuint program)
+{
+  Shadow& shadow = getShadow();
+  if (shadow.program == program)
+  {
+    shadow.program = UNKNOWN;
+  }
+}
+
+void crb::Graphics::State::forgetVertexArray(GLuint vertexArray)
+{
+  // Deleting the bound vertex array object reverts the binding to zero
+  Shadow& shadow = getShadow();
+  if (shadow.vertexArray == vertexArray)
+  {
+    shadow.vertexArray = 0;
+  }
+  shadow.elementBuffers.erase(vertexArray);
+}
+
+void crb::Graphics::State::forgetBuffer(GLuint buffer)
+{
+  // Deleting a bound buffer object reverts its bindings to zero
+  Shadow& shadow = getShadow();
+  for (auto& [target, current] : shadow.buffers)
+  {
+    if (current == buffer)
+    {
+      current = 0;
+    }
+  }
+  for (auto& [vertexArray, current] : shadow.elementBuffers)
+  {
+    if (current == buffer)
+    {
+      // Only the binding of the bound vertex array object is reverted
+      current = vertexArray == shadow.vertexArray ? 0 : UNKNOWN;
+    }
+  }
+}
+
+void crb::Graphics::State::forgetTexture(GLuint texture)
+{
+  // Deleting a bound texture reverts its bindings to zero
+  for (auto& [key, current] : getShadow().textures)
+  {
+    if (current == texture)
+    {
+      current = 0;
+    }
+  }
+}
+
+void crb::Graphics::State::invalidate()
+{
+  Shadow& shadow = getShadow();
+  shadow.program = UNKNOWN;
+  shadow.vertexArray = UNKNOWN;
+  shadow.activeTextureUnit = UNKNOWN;
+  shadow.polygonMode = GL_NONE;
+  shadow.depthMask = UNKNOWN;
+  shadow.buffers.clear();
+  shadow.elementBuffers.clear();
+  shadow.textures.clear();
+  shadow.capabilities.clear();
+}
+
+std::size_t crb::Graphics::State::getIssuedCallCount()
+{
+  return getShadow().issuedCalls;
+}
+
+std::size_t crb::Graphics::State::getSavedCallCount()
+{
+  return getShadow().savedCalls;
+}
+
+void crb::Graphics::State::resetCallCounts()
+{
+  Shadow& shadow = getShadow();
+  shadow.issuedCalls = 0;
+  shadow.savedCalls = 0;
+}
@@ -0,0 +1,206 @@
+#include "CRobes/StreamBuffer.hpp"
+
+#include <iostream>
+
+bool crb::Graphics::StreamBuffer::isPersistentSupported()
+{
+  return GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+}
+
+crb::Graphics::StreamBuffer::StreamBuffer(const GLenum target, const GLsizeiptr frameSize)
+: target(target), frameSize(frameSize > 0 ? frameSize : 1), persistent(crb::Graphics::StreamBuffer::isPersistentSupported())
+{
+  this->_create();
+}
+
+crb::Graphics::StreamBuffer::~StreamBuffer()
+{
+  this->_release();
+  for (Retired& buffer : this->retired)
+  {
+    if (buffer.fence != NULL)
+    {
+      glDeleteSync(buffer.fence);
+    }
+    glDeleteBuffers(1, &buffer.ID);
+  }
+}
+
+void crb::Graphics::StreamBuffer::nextFrame()
+{
+  if (this->mapped)
+  {
+    this->unmap();
+  }
+  this->cursor = 0;
+  this->_collectRetired();
+
+  if (!this->persistent)
+  {
+    // Orphaning, the draws of the previous frames keep reading the old storage
+    this->Bind();
+    glBufferData(this->target, this->frameSize, NULL, GL_STREAM_DRAW);
+    return;
+  }
+
+  // Everything submitted so far may read the current region
+  if (this->fences[this->region] != NULL)
+  {
+    glDeleteSync(this->fences[this->region]);
+  }
+  this->fences[this->region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  this->region = (this->region + 1) % FRAME_COUNT;
+
+  GLsync& fence = this->fences[this->region];
+  if (fence == NULL)
+  {
+    return;
+  }
+  if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+  {
+    this->stallCount++;
+    while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000u) == GL_TIMEOUT_EXPIRED)
+    {}
+  }
+  glDeleteSync(fence);
+  fence = NULL;
+}
+
+void* crb::Graphics::StreamBuffer::map(const GLsizeiptr size, const GLsizeiptr alignment, GLintptr& oOffset)
+{
+  if (this->mapped)
+  {
+    this->unmap();
+  }
+
+  // Aligning the offset in the whole buffer, since that is what draws see
+  GLsizeiptr regionStart = this->persistent ? (GLsizeiptr)this->region * this->frameSize : 0;
+  GLsizeiptr offset = regionStart + this->cursor;
+  if (alignment > 1 && offset % alignment != 0)
+  {
+    offset += alignment - offset % alignment;
+  }
+  if (offset + size > regionStart + this->frameSize)
+  {
+    GLsizeiptr grownSize = this->frameSize * 2;
+    while (grownSize < size)
+    {
+      grownSize *= 2;
+    }
+
+    // The draws of this frame may still read the old buffer, so it is retired instead of deleted
+    this->_release(true);
+    this->frameSize = grownSize;
+    this->_create();
+    regionStart = 0;
+    offset = 0;
+  }
+  this->cursor = offset + size - regionStart;
+  oOffset = offset;
+
+  if (this->persistent)
+  {
+    return this->mapping + oOffset;
+  }
+
+  this->Bind();
+  void* data = glMapBufferRange(
+    this->target,
+    oOffset,
+    size,
+    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT
+  );
+  this->mapped = data != NULL;
+  return data;
+}
+
+void crb::Graphics::StreamBuffer::unmap()
+{
+  // Persistent mappings are coherent, so the writes are already visible
+  if (!this->mapped)
+  {
+    return;
+  }
+  this->Bind();
+  glUnmapBuffer(this->target);
+  this->mapped = false;
+}
+
+void crb::Graphics::StreamBuffer::_create()
+{
+  glGenBuffers(1, &this->ID);
+  this->Bind();
+  if (!this->persistent)
+  {
+    glBufferData(this->target, this->frameSize, NULL, GL_STREAM_DRAW);
+    return;
+  }
+
+  const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  const GLsizeiptr size = this->frameSize * (GLsizeiptr)FRAME_COUNT;
+  glBufferStorage(this->target, size, NULL, flags);
+  this->mapping = (char*)glMapBufferRange(this->target, 0, size, flags);
+  if (this->mapping == NULL)
+  {
+    std::cerr << "Failed to map stream buffer persistently, falling back to orphaning!\n";
+    crb::Graphics::State::forgetBuffer(this->ID);
+    glDeleteBuffers(1, &this->ID);
+    this->persistent = false;
+    this->_create();
+  }
+}
+
+void crb::Graphics::StreamBuffer::_release(const bool retire)
+{
+  if (this->mapped || this->mapping != NULL)
+  {
+    this->Bind();
+    glUnmapBuffer(this->target);
+    this->mapped = false;
+    this->mapping = NULL;
+  }
+  crb::Graphics::State::forgetBuffer(this->ID);
+  if (retire)
+  {
+    this->retired.push_back({this->ID, NULL});
+  }
+  else
+  {
+    glDeleteBuffers(1, &this->ID);
+  }
+  this->ID = 0;
+
+  for (GLsync& fence : this->fences)
+  {
+    if (fence != NULL)
+    {
+      glDeleteSync(fence);
+      fence = NULL;
+    }
+  }
+  this->region = 0;
+}
+
+void crb::Graphics::StreamBuffer::_collectRetired()
+{
+  std::size_t kept {0u};
+  for (Retired& buffer : this->retired)
+  {
+    if (buffer.fence == NULL)
+    {
+      // Every draw reading the buffer was submitted during the frame that just ended
+      buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      this->retired[kept++] = buffer;
+      continue;
+    }
+    const GLenum status = glClientWaitSync(buffer.fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+    {
+      this->retired[kept++] = buffer;
+      continue;
+    }
+    glDeleteSync(buffer.fence);
+    glDeleteBuffers(1, &buffer.ID);
+  }
+  this->retired.resize(kept);
+}
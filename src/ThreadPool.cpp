@@ -0,0 +1,60 @@
+#include "CRobes/ThreadPool.hpp"
+
+crb::ThreadPool::ThreadPool(const unsigned int threadCount)
+{
+  unsigned int count = threadCount;
+  if (count == 0)
+  {
+    const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    count = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+  }
+
+  this->workers.reserve(count);
+  for (unsigned int i = 0; i < count; i++)
+  {
+    this->workers.emplace_back(&crb::ThreadPool::_work, this);
+  }
+}
+
+crb::ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock {this->mutex};
+    this->stopping = true;
+    this->jobs.clear();
+  }
+  this->condition.notify_all();
+  for (std::thread& worker : this->workers)
+  {
+    worker.join();
+  }
+}
+
+void crb::ThreadPool::submit(std::function<void()> job)
+{
+  {
+    std::lock_guard<std::mutex> lock {this->mutex};
+    this->jobs.push_back(std::move(job));
+  }
+  this->condition.notify_one();
+}
+
+void crb::ThreadPool::_work()
+{
+  CRB_PROFILE_THREAD("Worker");
+  while (true)
+  {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock {this->mutex};
+      this->condition.wait(lock, [this]() { return this->stopping || !this->jobs.empty(); });
+      if (this->stopping)
+      {
+        return;
+      }
+      job = std::move(this->jobs.front());
+      this->jobs.pop_front();
+    }
+    job();
+  }
+}
@@ -0,0 +1,70 @@
+#include "CRobes/VertexLayout.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+GLhalf crb::Graphics::toHalf(const float value)
+{
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  const std::uint32_t sign = (bits >> 16) & 0x8000u;
+  const std::uint32_t exponent = (bits >> 23) & 0xFFu;
+  std::uint32_t mantissa = bits & 0x7FFFFFu;
+
+  // Infinity and NaN, keeping NaN a NaN
+  if (exponent == 0xFFu)
+  {
+    return (GLhalf)(sign | 0x7C00u | (mantissa != 0 ? 0x200u : 0u));
+  }
+
+  const int halfExponent = (int)exponent - 127 + 15;
+  if (halfExponent >= 31)
+  {
+    return (GLhalf)(sign | 0x7C00u);
+  }
+  if (halfExponent <= 0)
+  {
+    // Too small even for a subnormal half
+    if (halfExponent < -10)
+    {
+      return (GLhalf)sign;
+    }
+    mantissa |= 0x800000u;
+    const unsigned int shift = (unsigned int)(14 - halfExponent);
+    std::uint32_t half = mantissa >> shift;
+    const std::uint32_t remainder = mantissa & ((1u << shift) - 1u);
+    const std::uint32_t halfway = 1u << (shift - 1u);
+    if (remainder > halfway || (remainder == halfway && (half & 1u) != 0))
+    {
+      half++;
+    }
+    return (GLhalf)(sign | half);
+  }
+
+  // Rounding to nearest even, a carry into the exponent is still the correct result
+  std::uint32_t half = ((std::uint32_t)halfExponent << 10) | (mantissa >> 13);
+  const std::uint32_t remainder = mantissa & 0x1FFFu;
+  if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u) != 0))
+  {
+    half++;
+  }
+  return (GLhalf)(sign | half);
+}
+
+void crb::Graphics::VertexLayout::apply() const
+{
+  for (std::size_t i = 0; i < this->attributeCount; i++)
+  {
+    const crb::Graphics::VertexAttribute& attribute = this->attributes[i];
+    glVertexAttribPointer(
+      attribute.location,
+      attribute.size,
+      attribute.type,
+      attribute.normalized,
+      this->stride,
+      (const void*)(std::size_t)attribute.offset
+    );
+    glEnableVertexAttribArray(attribute.location);
+  }
+}
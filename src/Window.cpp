@@ -1,5 +1,10 @@
 #include "CRobes/Window.hpp"
 
+#if defined(CRB_ENABLE_EGL)
+  #include <EGL/egl.h>
+  #include <EGL/eglext.h>
+#endif
+
 void framebufferSizeCallback(GLFWwindow* window, int width, int height)
 {
   crb::Window* windowInstance = (crb::Window*)glfwGetWindowUserPointer(window);
@@ -19,6 +24,10 @@ void framebufferSizeCallback(GLFWwindow* window, int width, int height)
 
 void crb::Window::loop()
 {
+  CRB_PROFILE_THREAD("Main");
+  this->makeContextCurrent();
+  // Keeps the time spent loading out of the first frame
+  this->lastTime = glfwGetTime();
   while (!glfwWindowShouldClose(this->glfwInstance))
   {
     this->_update();
@@ -66,30 +75,67 @@ void crb::Window::unmaximize()
   this->maximized = false;
 }
 
-void crb::Window::_initialize()
+void crb::Window::makeContextCurrent()
 {
-  this->glfwInstance= glfwCreateWindow(
-    this->width,
-    this->height,
-    this->title.c_str(),
-    NULL,
-    NULL
-  );
-  if (this->glfwInstance == NULL)
+#if defined(CRB_ENABLE_EGL)
+  if (this->eglContext != NULL)
   {
-    std::cerr << "Failed to create a GLFW Window!\n";
-    glfwTerminate();
+    eglMakeCurrent(this->eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, this->eglContext);
   }
+  else
+  {
+    glfwMakeContextCurrent(this->glfwInstance);
+  }
+#else
   glfwMakeContextCurrent(this->glfwInstance);
+#endif
+  crb::Graphics::State::setCache(&this->stateCache);
+  crb::Graphics::setMeshPool(&this->meshPool);
+}
+
+void crb::Window::_initialize()
+{
+  if (this->mode == crb::Window::Headless)
+  {
+    if (!this->_createHeadlessContext())
+    {
+      std::cerr << "Failed to create a headless context!\n";
+      glfwTerminate();
+    }
+  }
+  else
+  {
+    this->glfwInstance= glfwCreateWindow(
+      this->width,
+      this->height,
+      this->title.c_str(),
+      NULL,
+      NULL
+    );
+    if (this->glfwInstance == NULL)
+    {
+      std::cerr << "Failed to create a GLFW Window!\n";
+      glfwTerminate();
+    }
+  }
+  this->makeContextCurrent();
   glfwSetFramebufferSizeCallback(this->glfwInstance, framebufferSizeCallback);
   glfwSetWindowUserPointer(this->glfwInstance, this);
   glEnable(GL_DEPTH_TEST);
   glEnable(GL_BLEND);
   glEnable(GL_PRIMITIVE_RESTART);
   crb::Core::initializeGlew();
+  if (this->mode == crb::Window::Headless)
+  {
+    this->_createFramebuffer();
+  }
 
   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-  glPrimitiveRestartIndex(65535);
+  glPrimitiveRestartIndex(crb::PRIMITIVE_RESTART_INDEX);
+  crb::Graphics::State::setActiveTextureUnit(0);
+  this->cameraBuffer = new crb::Graphics::UBO(sizeof(crb::Camera::Block), crb::CAMERA_BLOCK_BINDING);
+  this->gpuTimer = new crb::Graphics::GpuTimer(crb::Graphics::GpuTimer::isRendererDeferred());
+  this->frameCapture = new crb::FrameCapture();
   glClearColor(
     this->clearColor.red,
     this->clearColor.green,
@@ -98,27 +144,161 @@ void crb::Window::_initialize()
   );
 }
 
+bool crb::Window::_createHeadlessContext()
+{
+  glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+#if defined(CRB_ENABLE_EGL)
+  // A surfaceless context needs neither a display server nor a window surface
+  auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+  EGLDisplay display = getPlatformDisplay != NULL
+    ? getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL)
+    : EGL_NO_DISPLAY;
+  if (display != EGL_NO_DISPLAY && eglInitialize(display, NULL, NULL) && eglBindAPI(EGL_OPENGL_API))
+  {
+    const EGLint contextAttributes[] {
+      EGL_CONTEXT_MAJOR_VERSION, 3,
+      EGL_CONTEXT_MINOR_VERSION, 3,
+      EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+      EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE, EGL_TRUE,
+      EGL_NONE
+    };
+    EGLContext context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttributes);
+    if (context != EGL_NO_CONTEXT && eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+    {
+      this->eglDisplay = display;
+      this->eglContext = context;
+
+      // The GLFW window only provides events and input
+      glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+      this->glfwInstance = glfwCreateWindow(this->width, this->height, this->title.c_str(), NULL, NULL);
+      glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
+      glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+      return this->glfwInstance != NULL;
+    }
+    if (context != EGL_NO_CONTEXT)
+    {
+      eglDestroyContext(display, context);
+    }
+    eglTerminate(display);
+  }
+#endif
+
+  this->glfwInstance = glfwCreateWindow(this->width, this->height, this->title.c_str(), NULL, NULL);
+  glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+  if (this->glfwInstance == NULL)
+  {
+    return false;
+  }
+  glfwMakeContextCurrent(this->glfwInstance);
+  glfwSwapInterval(0);
+  return true;
+}
+
+void crb::Window::_createFramebuffer()
+{
+  glGenFramebuffers(1, &this->framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, this->framebuffer);
+
+  glGenRenderbuffers(1, &this->colorBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, this->colorBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, this->width, this->height);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, this->colorBuffer);
+
+  glGenRenderbuffers(1, &this->depthBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, this->depthBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, this->width, this->height);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, this->depthBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+  {
+    std::cerr << "Failed to create the headless framebuffer!\n";
+  }
+  glViewport(0, 0, this->width, this->height);
+}
+
+void crb::Window::_throttle()
+{
+  GLsync& fence = this->frameFences[this->frameIndex % FRAMES_IN_FLIGHT];
+  if (fence != NULL)
+  {
+    while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000u) == GL_TIMEOUT_EXPIRED)
+    {}
+    glDeleteSync(fence);
+  }
+  fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  glFlush();
+  this->frameIndex++;
+}
+
+void crb::Window::_releaseHeadless()
+{
+  if (this->mode != crb::Window::Headless)
+  {
+    return;
+  }
+  for (GLsync& fence : this->frameFences)
+  {
+    if (fence != NULL)
+    {
+      glDeleteSync(fence);
+      fence = NULL;
+    }
+  }
+  glDeleteRenderbuffers(1, &this->colorBuffer);
+  glDeleteRenderbuffers(1, &this->depthBuffer);
+  glDeleteFramebuffers(1, &this->framebuffer);
+
+#if defined(CRB_ENABLE_EGL)
+  if (this->eglContext != NULL)
+  {
+    eglMakeCurrent(this->eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(this->eglDisplay, this->eglContext);
+    eglTerminate(this->eglDisplay);
+  }
+#endif
+}
+
 void crb::Window::_updateDeltaTime()
 {
-  float currentTime = (float)glfwGetTime();
-  this->deltaTime = currentTime - this->lastTime;
+  const double currentTime = glfwGetTime();
+  this->deltaTime = this->cameraPlayback != NULL
+    ? this->cameraPlayback->getTimestep()
+    : (float)(currentTime - this->lastTime);
+  this->frameStats.record((currentTime - this->lastTime) * 1000.0);
   this->lastTime = currentTime;
 }
 
 void crb::Window::_updateCamera()
 {
-  if (this->boundShader == NULL || this->boundCamera == NULL)
+  if (this->boundCamera == NULL)
   {
     return;
   }
-  if (this->mouseLocked)
+  if (this->cameraPlayback != NULL)
+  {
+    if (this->playbackFrame < this->cameraPlayback->getFrameCount())
+    {
+      this->cameraPlayback->apply(this->playbackFrame, *this->boundCamera);
+      this->playbackFrame++;
+    }
+  }
+  else if (this->mouseLocked)
   {
     std::pair<float, float> mousePosition = crb::Input::getMousePosition(this->glfwInstance);
     this->boundCamera->updatePosition(this->getDeltaTime());
     this->boundCamera->updateRotation(mousePosition);
   }
+  if (this->cameraRecording != NULL)
+  {
+    this->cameraRecording->record(*this->boundCamera);
+  }
   this->boundCamera->updateMatrix();
-  this->boundCamera->applyMatrix(*this->boundShader);
+
+  // Shared by every shader program, so switching programs needs no camera uploads
+  this->cameraBuffer->SetData(&this->boundCamera->getBlock());
+  this->cameraBuffer->BindBase();
 }
 
 void crb::Window::_updateCursor()
@@ -134,6 +314,7 @@ void crb::Window::_updateCursor()
 
 void crb::Window::_update()
 {
+  CRB_PROFILE_SCOPE("Window::update");
   glfwPollEvents();
   this->_updateDeltaTime();
   this->_updateCamera();
@@ -143,7 +324,34 @@ void crb::Window::_update()
 
 void crb::Window::_render()
 {
+  CRB_PROFILE_SCOPE("Window::render");
+  this->gpuTimer->beginFrame();
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  if (this->boundCamera != NULL)
+  {
+    this->renderQueue.begin(this->boundCamera->getPosition(), this->boundCamera->getZFar());
+  }
+  else
+  {
+    this->renderQueue.begin({0.f}, 1.f);
+  }
+  this->gpuTimer->begin("Immediate");
   this->render();
-  glfwSwapBuffers(this->glfwInstance);
+  this->gpuTimer->end();
+  {
+    CRB_PROFILE_SCOPE("RenderQueue::flush");
+    this->renderQueue.flush(this->gpuTimer);
+  }
+  this->frameCapture->capture(this->framebuffer, this->width, this->height);
+  if (this->mode == crb::Window::Headless)
+  {
+    this->_throttle();
+  }
+  else
+  {
+    glfwSwapBuffers(this->glfwInstance);
+  }
+
+  this->savedStateCalls = crb::Graphics::State::getSavedCallCount();
+  crb::Graphics::State::resetCallCounts();
 }